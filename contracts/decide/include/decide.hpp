@@ -11,9 +11,14 @@
 #include <eosio/eosio.hpp>
 #include <eosio/asset.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/crypto.hpp>
+#include <eosio/permission.hpp>
+#include <eosio/binary_extension.hpp>
 
 // #include <eosio.token/eosio.token.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <cmath>
 
 using namespace eosio;
@@ -50,19 +55,87 @@ namespace decidespace {
         static constexpr name election_n = "election"_n;
         static constexpr name poll_n = "poll"_n;
         static constexpr name leaderboard_n = "leaderboard"_n;
+
+        //minimum length of ballot description or content stored as a shared blob
+        static constexpr uint32_t blob_min_size = 256;
+
+        //compressed detail header: "DZ" || codec || original size (uint32 LE)
+        static constexpr uint32_t detail_header_size = 7;
+        static constexpr uint8_t detail_codec_lz4 = 1;
+        static constexpr uint32_t max_detail_size = 1048576; //1 MiB uncompressed
+
+        //maximum listener contracts notified by a ballot broadcast
+        static constexpr uint32_t max_subscribers = 16;
+
+        //maximum options per ballot, vote receipts store option indexes as uint8
+        static constexpr uint32_t max_ballot_options = 256;
         
-        //treasury settings: transferable, burnable, reclaimable, stakeable, unstakeable, maxmutable
+        //treasury settings: transferable, burnable, reclaimable, stakeable, unstakeable, maxmutable, mgrpaysram
 
         //treasury access: public, private, invite
 
+        //treasury notify policies: always, never, optin
+
         //ballot statuses: setup, voting, closed, cancelled, archived
 
-        //ballot settings: lightballot, revotable, voteliquid, votestake
+        //ballot settings: lightballot, revotable, voteliquid, votestake, votesnapshot, merklevote, allowdgate
 
         //voting methods: 1acct1vote, 1tokennvote, 1token1vote, 1tsquare1v, quadratic
 
         //ballot categories: proposal, referendum, election, poll, leaderboard
 
+        //======================== structs ========================
+
+        //balance at a point in time
+        struct checkpoint {
+            time_point_sec checkpoint_time;
+            int64_t liquid;
+            int64_t staked;
+
+            EOSLIB_SERIALIZE(checkpoint, (checkpoint_time)(liquid)(staked))
+        };
+
+        //vote signed off chain by voter, submitted by relayer
+        struct signed_vote {
+            name voter;
+            name ballot_name;
+            vector<name> options;
+            uint64_t nonce; //must be greater than voter's last nonce
+            public_key signing_key; //must satisfy voter's active permission
+            signature sig; //signature over sha256(chain_id, contract, voter, ballot_name, options, nonce)
+
+            EOSLIB_SERIALIZE(signed_vote, (voter)(ballot_name)(options)(nonce)(signing_key)(sig))
+        };
+
+        //option result in ranked order
+        struct ranked_option {
+            name option_name;
+            asset votes;
+            uint16_t bps; //share of total option votes in basis points
+
+            EOSLIB_SERIALIZE(ranked_option, (option_name)(votes)(bps))
+        };
+
+        //full ballot definition for single action ballot creation
+        struct ballot_spec {
+            name category;
+            symbol treasury_symbol;
+            name voting_method;
+            string title;
+            string description;
+            string content;
+            uint8_t min_options;
+            uint8_t max_options;
+            vector<name> options;
+            map<name, bool> settings; //overrides default settings
+            uint8_t winners; //number of winners, only election ballots can have more than 1
+
+            EOSLIB_SERIALIZE(ballot_spec, 
+                (category)(treasury_symbol)(voting_method)
+                (title)(description)(content)
+                (min_options)(max_options)(options)(settings)(winners))
+        };
+
         //======================== admin actions ========================
 
         //initialize contract
@@ -77,6 +150,9 @@ namespace decidespace {
         //updates time length
         ACTION updatetime(name time_name, uint32_t length);
 
+        //sets chain id used as signed vote domain
+        ACTION setchainid(checksum256 chain_id);
+
         //======================== treasury actions ========================
 
         //create a new treasury
@@ -123,6 +199,15 @@ namespace decidespace {
         ACTION unlock(symbol treasury_symbol);
         using unlock_action = action_wrapper<"unlock"_n, &decide::unlock>;
 
+        //sets which accounts are notified by mint, transfer, and burn
+        ACTION setnotify(symbol treasury_symbol, name policy);
+
+        //opts an account in to token action notifications on an optin treasury
+        ACTION optinnotify(name account, symbol treasury_symbol);
+
+        //opts an account out of token action notifications on an optin treasury
+        ACTION optoutnotify(name account, symbol treasury_symbol);
+
         //======================== payroll actions ========================
 
         //adds tokens to specified payroll
@@ -138,10 +223,25 @@ namespace decidespace {
             symbol treasury_symbol, name voting_method, vector<name> initial_options);
         using newballot_action = action_wrapper<"newballot"_n, &decide::newballot>;
 
+        //creates and opens a ballot from a full ballot spec
+        ACTION newballotfull(name ballot_name, name publisher, ballot_spec spec, time_point_sec end_time);
+
+        //creates or replaces a publisher's ballot template
+        ACTION settemplate(name publisher, name template_name, ballot_spec spec);
+
+        //deletes a publisher's ballot template
+        ACTION deltemplate(name publisher, name template_name);
+
+        //creates and opens a ballot from a publisher's ballot template
+        ACTION newfromtmpl(name ballot_name, name publisher, name template_name, time_point_sec end_time);
+
         //edits ballots details
         ACTION editdetails(name ballot_name, string title, string description, string content);
         using editdetails_action = action_wrapper<"editdetails"_n, &decide::editdetails>;
 
+        //edits ballot details with precompressed description and content
+        ACTION editdetailsz(name ballot_name, string title, vector<char> description, vector<char> content);
+
         //toggles ballot settings
         ACTION togglebal(name ballot_name, name setting_name);
         using togglebal_action = action_wrapper<"togglebal"_n, &decide::togglebal>;
@@ -150,6 +250,10 @@ namespace decidespace {
         ACTION editminmax(name ballot_name, uint8_t new_min_options, uint8_t new_max_options);
         using editminmax_action = action_wrapper<"editminmax"_n, &decide::editminmax>;
 
+        //sets number of winners on an election ballot
+        ACTION setwinners(name ballot_name, uint8_t winners);
+        using setwinners_action = action_wrapper<"setwinners"_n, &decide::setwinners>;
+
         //adds an option to a ballot
         ACTION addoption(name ballot_name, name new_option_name);
         using addoption_action = action_wrapper<"addoption"_n, &decide::addoption>;
@@ -162,6 +266,10 @@ namespace decidespace {
         ACTION openvoting(name ballot_name, time_point_sec end_time);
         using openvoting_action = action_wrapper<"openvoting"_n, &decide::openvoting>;
 
+        //commits a merkle root of voter balances and opens a ballot for voting
+        ACTION openmerkle(name ballot_name, time_point_sec end_time, checksum256 merkle_root);
+        using openmerkle_action = action_wrapper<"openmerkle"_n, &decide::openmerkle>;
+
         //cancels a ballot
         ACTION cancelballot(name ballot_name, string memo);
         using cancelballot_action = action_wrapper<"cancelballot"_n, &decide::cancelballot>;
@@ -182,6 +290,12 @@ namespace decidespace {
         ACTION broadcast(name ballot_name, map<name, asset> final_results, uint32_t total_voters);
         using broadcast_action = action_wrapper<"broadcast"_n, &decide::broadcast>;
 
+        //subscribes a listener contract to a ballot's broadcast
+        ACTION subscribe(name listener, name ballot_name);
+
+        //unsubscribes a listener contract from a ballot's broadcast, by listener or ballot publisher
+        ACTION unsubscribe(name listener, name ballot_name);
+
         //archives a ballot for a fee
         ACTION archive(name ballot_name, time_point_sec archived_until);
         using archive_action = action_wrapper<"archive"_n, &decide::archive>;
@@ -190,17 +304,32 @@ namespace decidespace {
         ACTION unarchive(name ballot_name, bool force);
         using unarchive_action = action_wrapper<"unarchive"_n, &decide::unarchive>;
 
+        //archives a ballot as a compact digest for a reduced fee
+        ACTION archdigest(name ballot_name, time_point_sec archived_until);
+
         //======================== voter actions ========================
 
         //registers a new voter
         ACTION regvoter(name voter, symbol treasury_symbol, optional<name> referrer);
 
+        //registers many new voters with a single authentication
+        ACTION regvoters(vector<name> voter_names, symbol treasury_symbol, optional<name> referrer);
+
         //unregisters an existing voter
         ACTION unregvoter(name voter, symbol treasury_symbol);
 
         //casts a vote on a ballot
         ACTION castvote(name voter, name ballot_name, vector<name> options);
 
+        //casts a vote on a ballot by option index, options are indexed in name order
+        ACTION castvoteidx(name voter, name ballot_name, vector<uint8_t> option_indexes);
+
+        //casts a vote on a merkle ballot with a proof of voter's committed weight
+        ACTION castmerkle(name voter, name ballot_name, vector<name> options, asset weight, vector<checksum256> proof);
+
+        //casts a batch of votes signed off chain by voters
+        ACTION castsigned(name relayer, vector<signed_vote> votes);
+
         //TODO: unvotes a single option
         // ACTION unvote(name voter, name ballot_name, name option_to_unvote);
 
@@ -216,6 +345,18 @@ namespace decidespace {
         //refreshes external balance
         ACTION refresh(name voter);
 
+        //registers voter as a delegate
+        ACTION regdelegate(name delegate_name, symbol treasury_symbol);
+
+        //unregisters a delegate with no constituents
+        ACTION unregdelegate(name delegate_name, symbol treasury_symbol);
+
+        //delegates voter's staked balance to a delegate, rebalancing both on listed delegate ballots
+        ACTION delegate(name voter, name delegate_name, symbol treasury_symbol, vector<name> ballot_names);
+
+        //returns voter's delegated balance from their delegate, rebalancing both on listed delegate ballots
+        ACTION undelegate(name voter, symbol treasury_symbol, vector<name> ballot_names);
+
         //======================== worker actions ========================
 
         //rebalance an unbalanced vote
@@ -224,6 +365,15 @@ namespace decidespace {
         //cleans up an expired vote
         ACTION cleanupvote(name voter, name ballot_name, optional<name> worker);
 
+        //migrates legacy vote rows on a ballot to receipts
+        ACTION migratevotes(name ballot_name, uint16_t count);
+
+        //adds ballots created before ballot indexes to the ballot index table
+        ACTION indexballots(name payer, uint16_t count);
+
+        //closes expired ballots, unarchives expired archivals, and forfeits stale labor
+        ACTION tick(uint16_t max_work);
+
         //unregisters an existing worker
         ACTION forfeitwork(name worker_name, symbol treasury_symbol);
 
@@ -252,6 +402,18 @@ namespace decidespace {
         ACTION assignseat(name committee_name, symbol treasury_symbol, name seat_name, name seat_holder, string memo);
         using assignseat_action = action_wrapper<"assignseat"_n, &decide::assignseat>;
 
+        //assigns new members to many committee seats
+        ACTION assignseats(name committee_name, symbol treasury_symbol, vector<pair<name, name>> assignments, string memo);
+        using assignseats_action = action_wrapper<"assignseats"_n, &decide::assignseats>;
+
+        //vacates many committee seats
+        ACTION vacateseats(name committee_name, symbol treasury_symbol, vector<name> seat_names, string memo);
+        using vacateseats_action = action_wrapper<"vacateseats"_n, &decide::vacateseats>;
+
+        //indexes current seat holders of a committee in their held seats
+        ACTION syncseats(name committee_name, symbol treasury_symbol);
+        using syncseats_action = action_wrapper<"syncseats"_n, &decide::syncseats>;
+
         //sets updater account and auth
         ACTION setupdater(name committee_name, symbol treasury_symbol, name updater_account, name updater_auth);
         using setupdater_action = action_wrapper<"setupdater"_n, &decide::setupdater>;
@@ -276,8 +438,9 @@ namespace decidespace {
 
         //========== utility methods ==========
 
-        //add quantity to liquid amount
-        void add_liquid(name voter, asset quantity);
+        //add quantity to liquid amount, creating voter on public treasuries if sender is given
+        //returns true if a new voter was created
+        bool add_liquid(name voter, asset quantity, name sender = name(0));
 
         //subtract quantity from liquid amount
         void sub_liquid(name voter, asset quantity);
@@ -288,6 +451,45 @@ namespace decidespace {
         //subtract quantity from staked amount
         void sub_stake(name voter, asset quantity);
 
+        //applies staked balance change to delegate's total delegated
+        void update_delegate(name delegate_name, asset delta);
+
+        //returns total delegated to delegate, zero if not a delegate
+        asset get_delegated_weight(name delegate_name, symbol treasury_symbol);
+
+        //appends a balance checkpoint to voter's balance history
+        void log_checkpoint(name voter, asset prev_liquid, asset prev_staked, asset new_liquid, asset new_staked);
+
+        //records begin time of a snapshot ballot on a treasury
+        void log_snapshot(symbol treasury_symbol, time_point_sec snapshot_time, name ram_payer);
+
+        //returns voter's liquid or staked balance as of snapshot time
+        asset get_snapshot_weight(name voter, asset current_weight, time_point_sec snapshot_time, bool use_stake);
+
+        //returns checkpoint window length in seconds
+        uint32_t get_checkpoint_window();
+
+        //returns config time, or default length if time doesn't exist
+        uint32_t get_config_time(name time_name, uint32_t default_length);
+
+        //returns config fee, or default fee if fee doesn't exist
+        asset get_config_fee(name fee_name, asset default_fee);
+
+        //validates compressed detail header
+        void validate_packed_detail(const vector<char>& detail);
+
+        //returns blob id from first 8 bytes of blob hash
+        uint64_t get_blob_id(const checksum256& hash);
+
+        //returns value of setting, false if setting doesn't exist
+        bool setting_enabled(const map<name, bool>& settings, name setting_name);
+
+        //verifies an (account, weight) leaf against a merkle root
+        bool verify_merkle_proof(checksum256 merkle_root, name account, asset weight, const vector<checksum256>& proof);
+
+        //returns digest signed by voter for a signed vote
+        checksum256 get_vote_digest(checksum256 chain_id, const signed_vote& vote);
+
         //validates category name
         bool valid_category(name category);
 
@@ -297,6 +499,12 @@ namespace decidespace {
         //validates access method
         bool valid_access_method(name access_method);
 
+        //validates notify policy
+        bool valid_notify_policy(name policy);
+
+        //notifies token action accounts according to treasury notify policy
+        void notify_holders(symbol treasury_symbol, vector<name> accounts);
+
         //charges a fee to a TLOS or TLOSD balance
         void require_fee(name account_name, asset fee);
 
@@ -330,8 +538,9 @@ namespace decidespace {
 
         //scope: get_self().value
         //ram: 
+        //NOTE: counters are frozen once the treasury's trsstats row exists
         TABLE treasury {
-            asset supply; //current supply
+            asset supply; //current supply, symbol is primary key
             asset max_supply; //maximum supply
             name access; //public, private, invite, membership
             name manager; //treasury manager
@@ -359,6 +568,43 @@ namespace decidespace {
         };
         typedef multi_index<name("treasuries"), treasury> treasuries_table;
 
+        //NOTE: treasuries created before trsstats have counters on treasury row until first update
+        //scope: get_self().value
+        //ram:
+        TABLE treasury_stats {
+            asset supply; //current supply
+            uint32_t voters;
+            uint32_t delegates;
+            uint32_t committees;
+            uint32_t open_ballots;
+
+            uint64_t primary_key() const { return supply.symbol.code().raw(); }
+            EOSLIB_SERIALIZE(treasury_stats, (supply)(voters)(delegates)(committees)(open_ballots))
+        };
+        typedef multi_index<name("trsstats"), treasury_stats> trsstats_table;
+
+        //NOTE: treasuries without a policy notify always
+        //scope: get_self().value
+        //ram:
+        TABLE notify_policy {
+            symbol treasury_symbol;
+            name policy; //never, optin
+
+            uint64_t primary_key() const { return treasury_symbol.code().raw(); }
+            EOSLIB_SERIALIZE(notify_policy, (treasury_symbol)(policy))
+        };
+        typedef multi_index<name("notifypolicy"), notify_policy> notifypolicy_table;
+
+        //scope: account.value
+        //ram:
+        TABLE notify_optin {
+            symbol treasury_symbol;
+
+            uint64_t primary_key() const { return treasury_symbol.code().raw(); }
+            EOSLIB_SERIALIZE(notify_optin, (treasury_symbol))
+        };
+        typedef multi_index<name("notifyoptins"), notify_optin> notifyoptins_table;
+
         //scope: treasury_symbol.code().raw()
         //ram:
         TABLE payroll {
@@ -431,6 +677,8 @@ namespace decidespace {
             time_point_sec begin_time; //time that voting begins
             time_point_sec end_time; //time that voting closes
 
+            binary_extension<uint8_t> winners; //number of winners, 1 if not set
+
             uint64_t primary_key() const { return ballot_name.value; }
             uint64_t by_category() const { return category.value; }
             uint64_t by_status() const { return status.value; }
@@ -442,7 +690,7 @@ namespace decidespace {
                 (title)(description)(content)
                 (treasury_symbol)(voting_method)(min_options)(max_options)(options)
                 (total_voters)(total_delegates)(total_raw_weight)(cleaned_count)(settings)
-                (begin_time)(end_time))
+                (begin_time)(end_time)(winners))
         };
         typedef multi_index<name("ballots"), ballot,
             indexed_by<name("bycategory"), const_mem_fun<ballot, uint64_t, &ballot::by_category>>,
@@ -451,6 +699,119 @@ namespace decidespace {
             indexed_by<name("byendtime"), const_mem_fun<ballot, uint64_t, &ballot::by_end_time>>
         > ballots_table;
 
+        //scope: publisher.value
+        //ram:
+        TABLE ballot_template {
+            name template_name;
+            ballot_spec spec;
+
+            uint64_t primary_key() const { return template_name.value; }
+            EOSLIB_SERIALIZE(ballot_template, (template_name)(spec))
+        };
+        typedef multi_index<name("baltemplates"), ballot_template> baltemplates_table;
+
+        //NOTE: blobs are shared between ballots of the same publisher, who pays for them
+        //scope: publisher.value
+        //ram:
+        TABLE blob {
+            uint64_t blob_id; //first 8 bytes of hash
+            checksum256 hash; //sha256 of data
+            string data;
+            uint32_t refs; //number of publisher's ballots referencing blob
+
+            uint64_t primary_key() const { return blob_id; }
+            EOSLIB_SERIALIZE(blob, (blob_id)(hash)(data)(refs))
+        };
+        typedef multi_index<name("blobs"), blob> blobs_table;
+
+        //NOTE: ballots with a metaref have empty description and/or content in the ballot row
+        //scope: get_self().value
+        //ram:
+        TABLE metaref {
+            name ballot_name;
+            name publisher; //scope of referenced blobs
+            checksum256 description_hash; //empty if description is inline
+            checksum256 content_hash; //empty if content is inline
+
+            uint64_t primary_key() const { return ballot_name.value; }
+            EOSLIB_SERIALIZE(metaref, (ballot_name)(publisher)(description_hash)(content_hash))
+        };
+        typedef multi_index<name("metarefs"), metaref> metarefs_table;
+
+        //NOTE: bytes start with a compressed detail header and are stored as submitted
+        //scope: get_self().value
+        //ram:
+        TABLE packed_details {
+            name ballot_name;
+            vector<char> description; //empty if description isn't compressed
+            vector<char> content; //empty if content isn't compressed
+
+            uint64_t primary_key() const { return ballot_name.value; }
+            EOSLIB_SERIALIZE(packed_details, (ballot_name)(description)(content))
+        };
+        typedef multi_index<name("zdetails"), packed_details> zdetails_table;
+
+        //scope: ballot_name.value
+        //ram:
+        TABLE subscriber {
+            name listener; //notified on broadcast
+
+            uint64_t primary_key() const { return listener.value; }
+            EOSLIB_SERIALIZE(subscriber, (listener))
+        };
+        typedef multi_index<name("subscribers"), subscriber> subscribers_table;
+
+        //NOTE: composite indexes live in a side table so existing ballot rows don't need reindexing
+        //scope: get_self().value
+        //ram:
+        TABLE ballot_index {
+            name ballot_name;
+            symbol treasury_symbol;
+            name status;
+            name publisher;
+            time_point_sec begin_time;
+            time_point_sec end_time;
+
+            //orders statuses within 8 bits so they fit in composite keys
+            static uint64_t status_rank(name status) {
+                switch (status.value) {
+                    case (name("setup").value): return 1;
+                    case (name("voting").value): return 2;
+                    case (name("closed").value): return 3;
+                    case (name("cancelled").value): return 4;
+                    case (name("archived").value): return 5;
+                    default: return 0;
+                }
+            }
+
+            uint64_t primary_key() const { return ballot_name.value; }
+            //treasury, status rank, end time
+            uint128_t by_trs_status() const { 
+                return (uint128_t(treasury_symbol.code().raw()) << 64) | (uint128_t(status_rank(status)) << 32) | end_time.utc_seconds;
+            }
+            //status, end time
+            uint128_t by_status_end() const { return (uint128_t(status.value) << 64) | end_time.utc_seconds; }
+            //publisher, begin time
+            uint128_t by_pub_time() const { return (uint128_t(publisher.value) << 64) | begin_time.utc_seconds; }
+
+            EOSLIB_SERIALIZE(ballot_index, (ballot_name)(treasury_symbol)(status)(publisher)(begin_time)(end_time))
+        };
+        typedef multi_index<name("ballotidx"), ballot_index,
+            indexed_by<name("bytrsstatus"), const_mem_fun<ballot_index, uint128_t, &ballot_index::by_trs_status>>,
+            indexed_by<name("bystatusend"), const_mem_fun<ballot_index, uint128_t, &ballot_index::by_status_end>>,
+            indexed_by<name("bypubtime"), const_mem_fun<ballot_index, uint128_t, &ballot_index::by_pub_time>>
+        > ballotidx_table;
+
+        //scope: singleton
+        //ram:
+        TABLE index_cursor {
+            name last_indexed; //last ballot visited by indexballots
+
+            EOSLIB_SERIALIZE(index_cursor, (last_indexed))
+        };
+        typedef singleton<name("idxcursor"), index_cursor> idxcursor_singleton;
+
+        //NOTE: legacy, votes are migrated to receipts
         //scope: ballot_name.value
         //ram: 
         TABLE vote {
@@ -474,6 +835,45 @@ namespace decidespace {
             indexed_by<name("bytime"), const_mem_fun<vote, uint64_t, &vote::by_time>>
         > votes_table;
 
+        //scope: ballot_name.value
+        //ram: 
+        TABLE receipt {
+            name voter;
+            bool is_delegate;
+            int64_t raw_votes; //in ballot treasury symbol
+            vector<uint8_t> selections; //option indexes in ballot options order
+            time_point_sec vote_time;
+            
+            name worker;
+            uint8_t rebalances;
+            int64_t rebalance_volume; //in ballot treasury symbol
+
+            uint64_t primary_key() const { return voter.value; }
+            EOSLIB_SERIALIZE(receipt, 
+                (voter)(is_delegate)(raw_votes)(selections)(vote_time)
+                (worker)(rebalances)(rebalance_volume))
+        };
+        typedef multi_index<name("receipts"), receipt> receipts_table;
+
+        //scope: get_self().value
+        //ram:
+        TABLE result {
+            name ballot_name;
+            symbol treasury_symbol;
+            vector<ranked_option> ranked_options; //sorted by votes descending, then option name
+            vector<name> winners; //options tied for most votes, or top options for multi-winner ballots
+            asset total_raw_weight; //total raw weight cast on ballot
+            uint32_t total_voters;
+            uint16_t turnout_bps; //total raw weight relative to treasury supply in basis points
+            time_point_sec close_time;
+
+            uint64_t primary_key() const { return ballot_name.value; }
+            EOSLIB_SERIALIZE(result, 
+                (ballot_name)(treasury_symbol)(ranked_options)(winners)
+                (total_raw_weight)(total_voters)(turnout_bps)(close_time))
+        };
+        typedef multi_index<name("results"), result> results_table;
+
         //scope: voter.value
         //ram: 
         TABLE voter {
@@ -494,6 +894,29 @@ namespace decidespace {
         };
         typedef multi_index<name("voters"), voter> voters_table;
 
+        //scope: voter.value
+        //ram: 
+        TABLE balance_history {
+            symbol treasury_symbol;
+            vector<checkpoint> checkpoints; //ordered by checkpoint_time
+
+            uint64_t primary_key() const { return treasury_symbol.code().raw(); }
+            EOSLIB_SERIALIZE(balance_history, (treasury_symbol)(checkpoints))
+        };
+        typedef multi_index<name("balhistory"), balance_history> balhistory_table;
+
+        //scope: get_self().value
+        //ram:
+        TABLE treasury_snapshot {
+            symbol treasury_symbol;
+            time_point_sec last_snapshot; //begin time of latest snapshot ballot
+            time_point_sec active_since; //begin time of first snapshot since history was last logged
+
+            uint64_t primary_key() const { return treasury_symbol.code().raw(); }
+            EOSLIB_SERIALIZE(treasury_snapshot, (treasury_symbol)(last_snapshot)(active_since))
+        };
+        typedef multi_index<name("snapshots"), treasury_snapshot> snapshots_table;
+
         //scope: treasury_symbol.code().raw()
         //ram: 
         TABLE delegate {
@@ -526,6 +949,17 @@ namespace decidespace {
         };
         typedef multi_index<name("committees"), committee> committees_table;
 
+        //scope: seat_holder.value
+        //ram:
+        TABLE held_seats {
+            symbol treasury_symbol;
+            vector<pair<name, name>> seats; //committee_name, seat_name
+
+            uint64_t primary_key() const { return treasury_symbol.code().raw(); }
+            EOSLIB_SERIALIZE(held_seats, (treasury_symbol)(seats))
+        };
+        typedef multi_index<name("heldseats"), held_seats> heldseats_table;
+
         //scope: get_self().value
         //ram:
         TABLE archival {
@@ -537,6 +971,24 @@ namespace decidespace {
         };
         typedef multi_index<name("archivals"), archival> archivals_table;
 
+        //scope: get_self().value
+        //ram:
+        TABLE ballot_digest {
+            name ballot_name;
+            name category;
+            name publisher;
+            name voting_method;
+            checksum256 metadata_hash; //sha256 of packed title, description, and content
+            time_point_sec begin_time;
+            time_point_sec end_time;
+
+            uint64_t primary_key() const { return ballot_name.value; }
+            EOSLIB_SERIALIZE(ballot_digest, 
+                (ballot_name)(category)(publisher)(voting_method)
+                (metadata_hash)(begin_time)(end_time))
+        };
+        typedef multi_index<name("digests"), ballot_digest> digests_table;
+
         //scope: treasury_symbol.code().raw()
         //ram:
         TABLE featured_ballot {
@@ -558,5 +1010,151 @@ namespace decidespace {
         };
         typedef multi_index<name("accounts"), account> accounts_table;
 
+        //scope: get_self().value
+        //ram:
+        TABLE merkle_root {
+            name ballot_name;
+            checksum256 root; //root of (account, weight) balance tree
+
+            uint64_t primary_key() const { return ballot_name.value; }
+            EOSLIB_SERIALIZE(merkle_root, (ballot_name)(root))
+        };
+        typedef multi_index<name("merkleroots"), merkle_root> merkleroots_table;
+
+        //scope: singleton
+        //ram:
+        TABLE sign_domain {
+            checksum256 chain_id;
+
+            EOSLIB_SERIALIZE(sign_domain, (chain_id))
+        };
+        typedef singleton<name("signdomain"), sign_domain> signdomain_singleton;
+
+        //scope: get_self().value
+        //ram:
+        TABLE vote_nonce {
+            name voter;
+            uint64_t last_nonce;
+
+            uint64_t primary_key() const { return voter.value; }
+            EOSLIB_SERIALIZE(vote_nonce, (voter)(last_nonce))
+        };
+        typedef multi_index<name("nonces"), vote_nonce> nonces_table;
+
+        //scope: singleton
+        //ram:
+        TABLE tick_cursor {
+            time_point_sec ballot_end_time; //end time of last ballot ticked
+            name ballot_name; //name of last ballot ticked
+            name archival_name; //next archival to tick
+            symbol labor_symbol; //treasury of next labor to tick
+            name labor_worker; //next labor to tick
+
+            EOSLIB_SERIALIZE(tick_cursor, (ballot_end_time)(ballot_name)(archival_name)(labor_symbol)(labor_worker))
+        };
+        typedef singleton<name("tickcursor"), tick_cursor> tickcursor_singleton;
+
+        //======================== table helpers ========================
+
+        //charges ballot fee, validates, and returns a new ballot in setup mode
+        ballot init_ballot(name ballot_name, name category, name publisher, 
+            symbol treasury_symbol, name voting_method, const vector<name>& initial_options);
+
+        //applies details, min/max options, and settings from a ballot spec
+        void apply_spec(ballot& bal, const ballot_spec& spec);
+
+        //creates and opens a ballot from a ballot spec with a single row write
+        void create_ballot(name ballot_name, name publisher, const ballot_spec& spec, time_point_sec end_time);
+
+        //validates ballot can open and counts it as an open ballot on its treasury
+        void validate_open(const ballot& bal, time_point_sec end_time);
+
+        //validates and opens a ballot for voting
+        void open_ballot(ballots_table& ballots, const ballot& bal, time_point_sec end_time);
+
+        //validates and closes a ballot, ram payer pays for results
+        void close_ballot(ballots_table& ballots, const ballot& bal, bool broadcast, name ram_payer);
+
+        //emplaces ballot index row
+        void add_ballot_index(const ballot& bal, name payer);
+
+        //updates ballot index row if ballot has been indexed
+        void sync_ballot_index(const ballot& bal);
+
+        //erases ballot index row if ballot has been indexed
+        void erase_ballot_index(name ballot_name);
+
+        //adds a reference to a publisher's blob, creating blob if it doesn't exist
+        checksum256 add_blob_ref(const string& data, name publisher);
+
+        //removes a reference to a publisher's blob, erasing blob when no references remain
+        void release_blob_ref(const checksum256& hash, name publisher);
+
+        //moves large details to shared blobs and replaces ballot's previous blob references
+        void store_details(name ballot_name, name payer, string& description, string& content);
+
+        //releases ballot's blob references and compressed details
+        void release_details(name ballot_name);
+
+        //fills description and content from ballot's blobs or compressed details
+        void resolve_details(name ballot_name, string& description, string& content);
+
+        //erases all subscribers of a ballot
+        void clear_subscribers(name ballot_name);
+
+        //writes ranked results of a closed ballot, turnout is relative to supply at close
+        void write_results(const ballot& bal, asset supply, name ram_payer);
+
+        //returns archived ballot to closed status, or erases digest if ballot was compacted
+        void release_archive(ballots_table& ballots, name ballot_name);
+
+        //adds a committee seat to holder's held seats
+        void add_held_seat(name holder, symbol treasury_symbol, name committee_name, name seat_name, name ram_payer);
+
+        //removes a committee seat from holder's held seats, erasing row when no seats remain
+        void remove_held_seat(name holder, symbol treasury_symbol, name committee_name, name seat_name);
+
+        //removes labor's unclaimed work from workers bucket and erases labor
+        void forfeit_labor(labors_table& labors, const labor& lab);
+
+        //returns treasury stats, reading counters from treasury row if stats haven't been written
+        treasury_stats get_trs_stats(const treasury& trs);
+
+        //returns snapshot times of a treasury, zero if treasury has never had a snapshot ballot
+        treasury_snapshot get_snapshot(symbol treasury_symbol);
+
+        //applies counter deltas to treasury stats, moving counters off treasury row on first update
+        void update_trs_stats(const treasury& trs, int64_t supply_delta, int32_t voters_delta, 
+            int32_t delegates_delta, int32_t open_ballots_delta);
+
+        //emplaces a new voter with empty balances
+        void add_voter(voters_table& voters, name voter, symbol treasury_symbol, name ram_payer);
+
+        //returns voter's raw vote weight on a ballot
+        asset get_vote_weight(name voter, const ballot& bal);
+
+        //returns option names for option indexes on a ballot
+        vector<name> get_options_by_index(const ballot& bal, const vector<uint8_t>& option_indexes);
+
+        //returns option indexes for option names on a ballot
+        vector<uint8_t> get_option_indexes(const ballot& bal, const vector<name>& options);
+
+        //recalculates weighted votes from a receipt
+        map<name, asset> get_receipt_weights(const ballot& bal, const receipt& rcpt);
+
+        //moves a legacy vote row to a receipt if one exists
+        void migrate_vote(receipts_table& receipts, const ballot& bal, name voter, name ram_payer);
+
+        //validates and applies a vote to a ballot
+        void apply_vote(ballots_table& ballots, const ballot& bal, name voter, vector<name> options, 
+            asset raw_vote_weight, name ram_payer);
+
+        //applies voter's current weight to an existing receipt
+        void rebalance_vote(ballots_table& ballots, const ballot& bal, receipts_table& receipts, const receipt& rcpt, 
+            optional<name> worker);
+
+        //rebalances voter's and delegate's receipts on a delegate ballot after a delegation change
+        void sync_delegation(name ballot_name, name voter, name delegate_name, symbol treasury_symbol);
+
     };
 }
\ No newline at end of file
@@ -10,69 +10,87 @@ ACTION decide::newballot(name ballot_name, name category, name publisher,
     //authenticate
     require_auth(publisher);
 
-    //open configs singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
-
-    //open treasuries table, get treasury
-    treasuries_table treasuries(get_self(), get_self().value);
-    auto& trs = treasuries.get(treasury_symbol.code().raw(), "treasury not found");
-
-    //open voters table, get voter
-    voters_table voters(get_self(), publisher.value);
-    auto& vtr = voters.get(treasury_symbol.code().raw(), "voter not found");
+    //build new ballot
+    ballot new_bal = init_ballot(ballot_name, category, publisher, treasury_symbol, voting_method, initial_options);
 
     //open ballots table
     ballots_table ballots(get_self(), get_self().value);
-    auto bal = ballots.find(ballot_name.value);
 
-    //charge ballot listing fee to publisher
-    require_fee(publisher, conf.fees.at(name("ballot")));
+    //emplace new ballot
+    ballots.emplace(publisher, [&](auto& col){
+        col = new_bal;
+    });
 
-    //validate
-    check(bal == ballots.end(), "ballot name already exists");
-    check(valid_category(category), "invalid category");
-    check(valid_voting_method(voting_method), "invalid voting method");
+    //index new ballot
+    add_ballot_index(new_bal, publisher);
 
-    //create initial options map, initial settings map
-    map<name, asset> new_initial_options;
-    map<name, bool> new_settings;
+}
 
-    //loop and assign initial options
-    //NOTE: duplicates are OK, they will be consolidated into 1 key anyway
-    for (name n : initial_options) {
-        new_initial_options[n] = asset(0, treasury_symbol);
+ACTION decide::newballotfull(name ballot_name, name publisher, ballot_spec spec, time_point_sec end_time) {
+
+    //authenticate
+    require_auth(publisher);
+
+    //create and open ballot
+    create_ballot(ballot_name, publisher, spec, end_time);
+
+}
+
+ACTION decide::settemplate(name publisher, name template_name, ballot_spec spec) {
+
+    //authenticate
+    require_auth(publisher);
+
+    //validate
+    check(valid_category(spec.category), "invalid category");
+    check(valid_voting_method(spec.voting_method), "invalid voting method");
+    check(spec.winners == 1 || spec.category == name("election"), "only election ballots can have multiple winners");
+    check(spec.winners > 0, "winners must be greater than zero");
+
+    //open templates table, search for template
+    baltemplates_table baltemplates(get_self(), publisher.value);
+    auto tmpl_itr = baltemplates.find(template_name.value);
+
+    if (tmpl_itr == baltemplates.end()) {
+        //emplace new template
+        baltemplates.emplace(publisher, [&](auto& col) {
+            col.template_name = template_name;
+            col.spec = spec;
+        });
+    } else {
+        //replace template spec
+        baltemplates.modify(tmpl_itr, same_payer, [&](auto& col) {
+            col.spec = spec;
+        });
     }
 
-    //intitial settings
-    new_settings[name("lightballot")] = false;
-    new_settings[name("revotable")] = true;
-    new_settings[name("voteliquid")] = false;
-    new_settings[name("votestake")] = trs.settings.at("stakeable"_n);
-    //TODO: new_settings[name("allowdgate")] = false;
+}
 
-    //emplace new ballot
-    ballots.emplace(publisher, [&](auto& col){
-        col.ballot_name = ballot_name;
-        col.category = category;
-        col.publisher = publisher;
-        col.status = name("setup");
-        col.title = "";
-        col.description = "";
-        col.content = "";
-        col.treasury_symbol = treasury_symbol;
-        col.voting_method = voting_method;
-        col.min_options = 1;
-        col.max_options = 1;
-        col.options = new_initial_options;
-        col.total_voters = 0;
-        col.total_delegates = 0;
-        col.total_raw_weight = asset(0, treasury_symbol);
-        col.cleaned_count = 0;
-        col.settings = new_settings;
-        col.begin_time = time_point_sec(0);
-        col.end_time = time_point_sec(0);
-    });
+ACTION decide::deltemplate(name publisher, name template_name) {
+
+    //open templates table, get template
+    baltemplates_table baltemplates(get_self(), publisher.value);
+    auto& tmpl = baltemplates.get(template_name.value, "template not found");
+
+    //authenticate
+    require_auth(publisher);
+
+    //erase template
+    baltemplates.erase(tmpl);
+
+}
+
+ACTION decide::newfromtmpl(name ballot_name, name publisher, name template_name, time_point_sec end_time) {
+
+    //open templates table, get template
+    baltemplates_table baltemplates(get_self(), publisher.value);
+    auto& tmpl = baltemplates.get(template_name.value, "template not found");
+
+    //authenticate
+    require_auth(publisher);
+
+    //create and open ballot
+    create_ballot(ballot_name, publisher, tmpl.spec, end_time);
 
 }
 
@@ -88,6 +106,9 @@ ACTION decide::editdetails(name ballot_name, string title, string description, s
     //validate
     check(bal.status == name("setup"), "ballot must be in setup mode to edit details");
 
+    //store large details as shared blobs
+    store_details(ballot_name, bal.publisher, description, content);
+
     //update ballot details
     ballots.modify(bal, same_payer, [&](auto& col) {
         col.title = title;
@@ -97,6 +118,89 @@ ACTION decide::editdetails(name ballot_name, string title, string description, s
 
 }
 
+ACTION decide::editdetailsz(name ballot_name, string title, vector<char> description, vector<char> content) {
+
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //validate
+    check(bal.status == name("setup"), "ballot must be in setup mode to edit details");
+    check(!description.empty() || !content.empty(), "must submit compressed description or content");
+    validate_packed_detail(description);
+    validate_packed_detail(content);
+
+    //NOTE: empty details are left unchanged, whether inline, blob, or compressed
+
+    //open metarefs table, search for metaref
+    metarefs_table metarefs(get_self(), get_self().value);
+    auto mr_itr = metarefs.find(ballot_name.value);
+
+    //release blobs replaced by compressed details
+    if (mr_itr != metarefs.end()) {
+
+        //initialize
+        checksum256 description_hash = description.empty() ? mr_itr->description_hash : checksum256();
+        checksum256 content_hash = content.empty() ? mr_itr->content_hash : checksum256();
+
+        if (description_hash != mr_itr->description_hash) {
+            release_blob_ref(mr_itr->description_hash, mr_itr->publisher);
+        }
+
+        if (content_hash != mr_itr->content_hash) {
+            release_blob_ref(mr_itr->content_hash, mr_itr->publisher);
+        }
+
+        //erase metaref if no blobs remain, update otherwise
+        if (description_hash == checksum256() && content_hash == checksum256()) {
+            metarefs.erase(mr_itr);
+        } else {
+            metarefs.modify(mr_itr, same_payer, [&](auto& col) {
+                col.description_hash = description_hash;
+                col.content_hash = content_hash;
+            });
+        }
+    }
+
+    //open compressed details table, search for compressed details
+    zdetails_table zdetails(get_self(), get_self().value);
+    auto zd_itr = zdetails.find(ballot_name.value);
+
+    if (zd_itr == zdetails.end()) {
+        //emplace compressed details
+        zdetails.emplace(bal.publisher, [&](auto& col) {
+            col.ballot_name = ballot_name;
+            col.description = description;
+            col.content = content;
+        });
+    } else {
+        //replace submitted compressed details
+        zdetails.modify(zd_itr, bal.publisher, [&](auto& col) {
+            if (!description.empty()) {
+                col.description = description;
+            }
+            if (!content.empty()) {
+                col.content = content;
+            }
+        });
+    }
+
+    //update ballot details
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.title = title;
+        if (!description.empty()) {
+            col.description = "";
+        }
+        if (!content.empty()) {
+            col.content = "";
+        }
+    });
+
+}
+
 ACTION decide::togglebal(name ballot_name, name setting_name) {
     
     //open ballots table, get ballot
@@ -142,6 +246,27 @@ ACTION decide::editminmax(name ballot_name, uint8_t new_min_options, uint8_t new
 
 }
 
+ACTION decide::setwinners(name ballot_name, uint8_t winners) {
+    
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //validate
+    check(bal.status == name("setup"), "ballot must be in setup mode to set winners");
+    check(bal.category == name("election"), "only election ballots can have multiple winners");
+    check(winners > 0, "winners must be greater than zero");
+
+    //update ballot winners
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.winners = winners;
+    });
+
+}
+
 ACTION decide::addoption(name ballot_name, name new_option_name) {
     
     //open ballots table, get ballot
@@ -154,6 +279,7 @@ ACTION decide::addoption(name ballot_name, name new_option_name) {
     //validate
     check(bal.status == name("setup"), "ballot must be in setup mode to add options");
     check(bal.options.find(new_option_name) == bal.options.end(), "option is already in ballot");
+    check(bal.options.size() < max_ballot_options, "ballot cannot have more than 256 options");
 
     ballots.modify(bal, same_payer, [&](auto& col) {
         col.options[new_option_name] = asset(0, bal.treasury_symbol);
@@ -201,34 +327,44 @@ ACTION decide::openvoting(name ballot_name, time_point_sec end_time) {
     //authenticate
     require_auth(bal.publisher);
 
-    //initialize
-    auto now = time_point_sec(current_time_point());
+    //open ballot for voting
+    open_ballot(ballots, bal, end_time);
 
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+}
 
-    //open treasuries table, get treasury
-    treasuries_table treasuries(get_self(), get_self().value);
-    auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
+ACTION decide::openmerkle(name ballot_name, time_point_sec end_time, checksum256 merkle_root) {
+    
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
 
-    //update open ballots on treasury
-    treasuries.modify(trs, same_payer, [&](auto& col) {
-        col.open_ballots += 1;
-    });
+    //authenticate
+    require_auth(bal.publisher);
+
+    //open merkle roots table, search for merkle root
+    merkleroots_table merkleroots(get_self(), get_self().value);
+    auto mr_itr = merkleroots.find(ballot_name.value);
 
     //validate
-    check(bal.options.size() >= 2, "ballot must have at least 2 options");
-    check(bal.status == name("setup"), "ballot must be in setup mode to ready");
-    check(end_time.sec_since_epoch() > now.sec_since_epoch(), "end time must be in the future");
-    check(end_time.sec_since_epoch() - now.sec_since_epoch() >= conf.times.at(name("minballength")), "ballot must be open for minimum ballot length");
+    check(mr_itr == merkleroots.end(), "merkle root already committed");
+    check(merkle_root != checksum256(), "merkle root cannot be empty");
+    check(!setting_enabled(bal.settings, name("votesnapshot")), "merkle ballot cannot also be a snapshot ballot");
+    check(!setting_enabled(bal.settings, name("allowdgate")), "merkle ballot cannot allow delegates");
+
+    //commit merkle root
+    merkleroots.emplace(bal.publisher, [&](auto& col) {
+        col.ballot_name = ballot_name;
+        col.root = merkle_root;
+    });
 
+    //mark ballot as merkle ballot
     ballots.modify(bal, same_payer, [&](auto& col) {
-        col.status = name("voting");
-        col.begin_time = now;
-        col.end_time = end_time;
+        col.settings[name("merklevote")] = true;
     });
 
+    //open ballot for voting
+    open_ballot(ballots, bal, end_time);
+
 }
 
 ACTION decide::cancelballot(name ballot_name, string memo) {
@@ -248,15 +384,16 @@ ACTION decide::cancelballot(name ballot_name, string memo) {
     auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
 
     //update open ballots on treasury
-    treasuries.modify(trs, same_payer, [&](auto& col) {
-        col.open_ballots -= 1;
-    });
+    update_trs_stats(trs, 0, 0, 0, -1);
 
     //update ballot status
     ballots.modify(bal, same_payer, [&](auto& col) {
         col.status = name("cancelled");
     });
 
+    //update ballot index
+    sync_ballot_index(bal);
+
 }
 
 ACTION decide::deleteballot(name ballot_name) {
@@ -281,6 +418,33 @@ ACTION decide::deleteballot(name ballot_name) {
     check(now > bal.end_time + conf.times.at(name("balcooldown")), "cannot delete until 5 days past ballot's end time");
     check(bal.cleaned_count == bal.total_voters, "must clean all ballot votes before deleting");
 
+    //open merkle roots table, search for merkle root
+    merkleroots_table merkleroots(get_self(), get_self().value);
+    auto mr_itr = merkleroots.find(ballot_name.value);
+
+    //erase merkle root if merkle ballot
+    if (mr_itr != merkleroots.end()) {
+        merkleroots.erase(mr_itr);
+    }
+
+    //open results table, search for results
+    results_table results(get_self(), get_self().value);
+    auto res_itr = results.find(ballot_name.value);
+
+    //erase results if ballot was closed
+    if (res_itr != results.end()) {
+        results.erase(res_itr);
+    }
+
+    //release ballot blobs
+    release_details(ballot_name);
+
+    //erase subscribers
+    clear_subscribers(ballot_name);
+
+    //erase ballot index
+    erase_ballot_index(ballot_name);
+
     //erase ballot
     ballots.erase(bal);
 
@@ -322,45 +486,8 @@ ACTION decide::closevoting(name ballot_name, bool broadcast) {
     //authenticate
     require_auth(bal.publisher);
 
-    //validate
-    check(bal.status == name("voting"), "ballot must be in voting mode to close");
-    check(bal.end_time < time_point_sec(current_time_point()), "must be past ballot end time to close");
-
-    //change ballot status
-    ballots.modify(bal, same_payer, [&](auto& col) {
-        col.status = name("closed");
-    });
-
-    //open treasuries table, get treasury
-    treasuries_table treasuries(get_self(), get_self().value);
-    auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
-
-    //update open ballots on treasury
-    treasuries.modify(trs, same_payer, [&](auto& col) {
-        col.open_ballots -= 1;
-    });
-
-    //perform 1tokensquare1v final sqrt()
-    //NOTE: lightballots will already have sqrt() applied
-    if (bal.voting_method == name("1tsquare1v") && !bal.settings.at(name("lightballot"))) {
-        map<name, asset> squared_options = bal.options;
-
-        //square root total votes on each option
-        for (auto i = squared_options.begin(); i != squared_options.end(); i++) {
-            squared_options[i->first] = asset(sqrtl(i->second.amount), bal.treasury_symbol);
-        }
-
-        //update vote counts
-        ballots.modify(bal, same_payer, [&](auto& col) {
-            col.options = squared_options;
-        });
-    }
-
-    //if broadcast true, send broadcast inline to self
-    if (broadcast) {
-        broadcast_action broadcast_act(get_self(), { get_self(), active_permission });
-        broadcast_act.send(ballot_name, bal.options, bal.total_voters);
-    }
+    //close ballot
+    close_ballot(ballots, bal, broadcast, bal.publisher);
 
 }
 
@@ -381,6 +508,60 @@ ACTION decide::broadcast(name ballot_name, map<name, asset> final_results, uint3
 
     //notify ballot publisher (for external contract processing)
     require_recipient(bal.publisher);
+
+    //open subscribers table
+    subscribers_table subscribers(get_self(), ballot_name.value);
+
+    //notify subscribed listeners
+    for (auto sub_itr = subscribers.begin(); sub_itr != subscribers.end(); sub_itr++) {
+        require_recipient(sub_itr->listener);
+    }
+}
+
+ACTION decide::subscribe(name listener, name ballot_name) {
+
+    //authenticate
+    require_auth(listener);
+
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //open subscribers table, search for subscriber
+    subscribers_table subscribers(get_self(), ballot_name.value);
+    auto sub_itr = subscribers.find(listener.value);
+
+    //count subscribers
+    uint32_t sub_count = std::distance(subscribers.begin(), subscribers.end());
+
+    //validate
+    check(bal.status == name("setup") || bal.status == name("voting"), "ballot must be in setup or voting mode to subscribe");
+    check(sub_itr == subscribers.end(), "listener already subscribed");
+    check(sub_count < max_subscribers, "ballot has maximum subscribers");
+
+    //emplace subscriber, listener pays
+    subscribers.emplace(listener, [&](auto& col) {
+        col.listener = listener;
+    });
+
+}
+
+ACTION decide::unsubscribe(name listener, name ballot_name) {
+
+    //open subscribers table, get subscriber
+    subscribers_table subscribers(get_self(), ballot_name.value);
+    auto& sub = subscribers.get(listener.value, "subscriber not found");
+
+    //authenticate, ballot publisher can remove any listener
+    if (!has_auth(listener)) {
+        ballots_table ballots(get_self(), get_self().value);
+        auto bal_itr = ballots.find(ballot_name.value);
+        check(bal_itr != ballots.end() && has_auth(bal_itr->publisher), "missing authority of listener or ballot publisher");
+    }
+
+    //erase subscriber
+    subscribers.erase(sub);
+
 }
 
 ACTION decide::archive(name ballot_name, time_point_sec archived_until) {
@@ -409,7 +590,7 @@ ACTION decide::archive(name ballot_name, time_point_sec archived_until) {
     check(archived_until.sec_since_epoch() > now, "archived until must be in the future");
     
     //calculate archive fee
-    asset archival_fee = asset(conf.fees.at(name("archive")).amount * int64_t(days_to_archive), TLOS_SYM);
+    asset archival_fee = asset(conf.fees.at(name("archival")).amount * int64_t(days_to_archive), TLOS_SYM);
 
     //charge ballot publisher total fee
     require_fee(bal.publisher, archival_fee);
@@ -425,36 +606,694 @@ ACTION decide::archive(name ballot_name, time_point_sec archived_until) {
         col.status = name("archived");
     });
 
+    //update ballot index
+    sync_ballot_index(bal);
+
 }
 
 ACTION decide::unarchive(name ballot_name, bool force) {
     
-    //open ballots table, get ballot
-    ballots_table ballots(get_self(), get_self().value);
-    auto& bal = ballots.get(ballot_name.value, "ballot not found");
-
     //open archivals table, get archival
     archivals_table archivals(get_self(), get_self().value);
     auto& arch = archivals.get(ballot_name.value, "archival not found");
 
+    //open ballots table, search for ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto bal_itr = ballots.find(ballot_name.value);
+
     //initialize
     auto now = time_point_sec(current_time_point());
 
     //authenticate if force unarchive is true
     if (force) {
-        //authenticate
-        require_auth(bal.publisher);
+        //NOTE: compacted ballots only have a digest left
+        if (bal_itr != ballots.end()) {
+            require_auth(bal_itr->publisher);
+        } else {
+            digests_table digests(get_self(), get_self().value);
+            auto& dig = digests.get(ballot_name.value, "digest not found");
+            require_auth(dig.publisher);
+        }
     } else {
         //validate
         check(arch.archived_until < now, "ballot hasn't reached end of archival time");
     }
 
-    //change ballot status to closed
-    ballots.modify(bal, same_payer, [&](auto& col) {
-        col.status = name("closed");
-    });
+    //return ballot to closed status or erase digest
+    release_archive(ballots, ballot_name);
 
     //erase archival
     archivals.erase(arch);
 
-}
\ No newline at end of file
+}
+
+ACTION decide::archdigest(name ballot_name, time_point_sec archived_until) {
+
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //open configs singleton, get config
+    config_singleton configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //open archivals table, search for archival
+    archivals_table archivals(get_self(), get_self().value);
+    auto arch = archivals.find(ballot_name.value);
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //initialize
+    auto now = time_point_sec(current_time_point()).sec_since_epoch();
+    uint32_t days_to_archive = (archived_until.sec_since_epoch() - now) / uint32_t(86400) + 1;
+
+    //validate
+    check(arch == archivals.end(), "ballot is already archived");
+    check(bal.status == name("closed"), "ballot must be closed to archive");
+    check(archived_until.sec_since_epoch() > now, "archived until must be in the future");
+    check(bal.cleaned_count == bal.total_voters, "must clean all ballot votes before compacting");
+
+    //calculate digest archive fee
+    //NOTE: defaults to a tenth of the archival fee for configs initialized without it
+    asset digest_fee = get_config_fee(name("digestarch"), asset(conf.fees.at(name("archival")).amount / 10, TLOS_SYM));
+    asset archival_fee = asset(digest_fee.amount * int64_t(days_to_archive), TLOS_SYM);
+
+    //charge ballot publisher total fee
+    require_fee(bal.publisher, archival_fee);
+
+    //open results table, search for results
+    results_table results(get_self(), get_self().value);
+    auto res_itr = results.find(ballot_name.value);
+
+    //write results if ballot was closed before results were kept
+    //NOTE: supply at close is unknown, so turnout is left at zero
+    if (res_itr == results.end()) {
+        write_results(bal, asset(0, bal.treasury_symbol), bal.publisher);
+    }
+
+    //resolve details stored as blobs
+    string description = bal.description;
+    string content = bal.content;
+    resolve_details(ballot_name, description, content);
+
+    //hash ballot metadata
+    //NOTE: full metadata can be rebuilt from newballot and editdetails action history
+    auto packed = pack(std::make_tuple(bal.title, description, content));
+
+    //release ballot blobs
+    release_details(ballot_name);
+
+    //open digests table
+    digests_table digests(get_self(), get_self().value);
+
+    //emplace digest
+    digests.emplace(bal.publisher, [&](auto& col) {
+        col.ballot_name = ballot_name;
+        col.category = bal.category;
+        col.publisher = bal.publisher;
+        col.voting_method = bal.voting_method;
+        col.metadata_hash = sha256(packed.data(), packed.size());
+        col.begin_time = bal.begin_time;
+        col.end_time = bal.end_time;
+    });
+
+    //emplace in archived table
+    archivals.emplace(bal.publisher, [&](auto& col) {
+        col.ballot_name = ballot_name;
+        col.archived_until = archived_until;
+    });
+
+    //open merkle roots table, search for merkle root
+    merkleroots_table merkleroots(get_self(), get_self().value);
+    auto mr_itr = merkleroots.find(ballot_name.value);
+
+    //erase merkle root if merkle ballot
+    if (mr_itr != merkleroots.end()) {
+        merkleroots.erase(mr_itr);
+    }
+
+    //erase subscribers
+    clear_subscribers(ballot_name);
+
+    //erase ballot index
+    erase_ballot_index(ballot_name);
+
+    //erase ballot
+    ballots.erase(bal);
+
+}
+
+//======================== ballot helpers ========================
+
+ballot decide::init_ballot(name ballot_name, name category, name publisher, 
+    symbol treasury_symbol, name voting_method, const vector<name>& initial_options) {
+
+    //open configs singleton, get config
+    config_singleton configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //open treasuries table, get treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(treasury_symbol.code().raw(), "treasury not found");
+
+    //open voters table, get voter
+    voters_table voters(get_self(), publisher.value);
+    auto& vtr = voters.get(treasury_symbol.code().raw(), "voter not found");
+
+    //open ballots table
+    ballots_table ballots(get_self(), get_self().value);
+    auto bal = ballots.find(ballot_name.value);
+
+    //open digests table, search for digest
+    digests_table digests(get_self(), get_self().value);
+    auto dig = digests.find(ballot_name.value);
+
+    //charge ballot listing fee to publisher
+    require_fee(publisher, conf.fees.at(name("ballot")));
+
+    //validate
+    check(bal == ballots.end(), "ballot name already exists");
+    check(dig == digests.end(), "ballot name reserved by archived digest");
+    check(valid_category(category), "invalid category");
+    check(valid_voting_method(voting_method), "invalid voting method");
+
+    //create initial options map, initial settings map
+    map<name, asset> new_initial_options;
+    map<name, bool> new_settings;
+
+    //loop and assign initial options
+    //NOTE: duplicates are OK, they will be consolidated into 1 key anyway
+    for (name n : initial_options) {
+        new_initial_options[n] = asset(0, treasury_symbol);
+    }
+
+    //validate
+    check(new_initial_options.size() <= max_ballot_options, "ballot cannot have more than 256 options");
+
+    //intitial settings
+    new_settings[name("lightballot")] = false;
+    new_settings[name("revotable")] = true;
+    new_settings[name("voteliquid")] = false;
+    new_settings[name("votestake")] = trs.settings.at("stakeable"_n);
+    new_settings[name("votesnapshot")] = false;
+    new_settings[name("allowdgate")] = false;
+
+    //build new ballot
+    ballot new_bal;
+    new_bal.ballot_name = ballot_name;
+    new_bal.category = category;
+    new_bal.publisher = publisher;
+    new_bal.status = name("setup");
+    new_bal.title = "";
+    new_bal.description = "";
+    new_bal.content = "";
+    new_bal.treasury_symbol = treasury_symbol;
+    new_bal.voting_method = voting_method;
+    new_bal.min_options = 1;
+    new_bal.max_options = 1;
+    new_bal.options = new_initial_options;
+    new_bal.total_voters = 0;
+    new_bal.total_delegates = 0;
+    new_bal.total_raw_weight = asset(0, treasury_symbol);
+    new_bal.cleaned_count = 0;
+    new_bal.settings = new_settings;
+    new_bal.begin_time = time_point_sec(0);
+    new_bal.end_time = time_point_sec(0);
+
+    return new_bal;
+}
+
+void decide::apply_spec(ballot& bal, const ballot_spec& spec) {
+
+    //validate
+    check(spec.min_options > 0 && spec.max_options > 0, "min and max options must be greater than zero");
+    check(spec.max_options >= spec.min_options, "max must be greater than or equal to min");
+    check(spec.max_options <= bal.options.size(), "max options cannot be greater than number of options");
+
+    //apply details and min/max options
+    bal.title = spec.title;
+    bal.description = spec.description;
+    bal.content = spec.content;
+    bal.min_options = spec.min_options;
+    bal.max_options = spec.max_options;
+
+    //apply winners, validated same as setwinners
+    check(spec.winners == 1 || bal.category == name("election"), "only election ballots can have multiple winners");
+    check(spec.winners > 0, "winners must be greater than zero");
+    if (spec.winners > 1) {
+        bal.winners = spec.winners;
+    }
+
+    //apply setting overrides
+    for (auto i = spec.settings.begin(); i != spec.settings.end(); i++) {
+        auto set_itr = bal.settings.find(i->first);
+        check(set_itr != bal.settings.end(), "setting not found");
+        set_itr->second = i->second;
+    }
+
+}
+
+void decide::create_ballot(name ballot_name, name publisher, const ballot_spec& spec, time_point_sec end_time) {
+
+    //build ballot from spec
+    ballot new_bal = init_ballot(ballot_name, spec.category, publisher, spec.treasury_symbol, spec.voting_method, spec.options);
+    apply_spec(new_bal, spec);
+
+    //store large details as shared blobs
+    store_details(ballot_name, publisher, new_bal.description, new_bal.content);
+
+    //validate and open ballot
+    validate_open(new_bal, end_time);
+    new_bal.status = name("voting");
+    new_bal.begin_time = time_point_sec(current_time_point());
+    new_bal.end_time = end_time;
+
+    //open ballots table
+    ballots_table ballots(get_self(), get_self().value);
+
+    //emplace new ballot
+    ballots.emplace(publisher, [&](auto& col) {
+        col = new_bal;
+    });
+
+    //index new ballot
+    add_ballot_index(new_bal, publisher);
+
+}
+
+void decide::validate_open(const ballot& bal, time_point_sec end_time) {
+
+    //initialize
+    auto now = time_point_sec(current_time_point());
+
+    //open config singleton, get config
+    config_singleton configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //open treasuries table, get treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
+
+    //validate
+    check(bal.options.size() >= 2, "ballot must have at least 2 options");
+    check(bal.options.size() <= max_ballot_options, "ballot cannot have more than 256 options");
+    check(bal.options.size() > bal.winners.value_or(1), "ballot must have more options than winners");
+    check(bal.status == name("setup"), "ballot must be in setup mode to ready");
+    check(end_time.sec_since_epoch() > now.sec_since_epoch(), "end time must be in the future");
+    check(end_time.sec_since_epoch() - now.sec_since_epoch() >= conf.times.at(name("minballength")), "ballot must be open for minimum ballot length");
+
+    //delegated stake is only counted on stake ballots
+    if (setting_enabled(bal.settings, name("allowdgate"))) {
+        check(bal.settings.at(name("votestake")), "delegate ballot must vote with stake");
+    }
+
+    //snapshot ballots can only read balances within the checkpoint window
+    if (setting_enabled(bal.settings, name("votesnapshot"))) {
+        check(!setting_enabled(bal.settings, name("allowdgate")), "snapshot ballot cannot allow delegates");
+        check(end_time.sec_since_epoch() - now.sec_since_epoch() <= get_checkpoint_window(), "snapshot ballot cannot be open longer than checkpoint window");
+
+        //keep checkpoints at or before begin time from being merged
+        log_snapshot(bal.treasury_symbol, now, bal.publisher);
+    }
+
+    //update open ballots on treasury
+    update_trs_stats(trs, 0, 0, 0, 1);
+
+}
+
+void decide::open_ballot(ballots_table& ballots, const ballot& bal, time_point_sec end_time) {
+
+    //validate
+    validate_open(bal, end_time);
+
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.status = name("voting");
+        col.begin_time = time_point_sec(current_time_point());
+        col.end_time = end_time;
+    });
+
+    //update ballot index
+    sync_ballot_index(bal);
+
+}
+
+void decide::close_ballot(ballots_table& ballots, const ballot& bal, bool broadcast, name ram_payer) {
+
+    //validate
+    check(bal.status == name("voting"), "ballot must be in voting mode to close");
+    check(bal.end_time < time_point_sec(current_time_point()), "must be past ballot end time to close");
+
+    //change ballot status
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.status = name("closed");
+    });
+
+    //update ballot index
+    sync_ballot_index(bal);
+
+    //open treasuries table, get treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
+
+    //update open ballots on treasury
+    update_trs_stats(trs, 0, 0, 0, -1);
+
+    //read supply as of close for turnout
+    asset supply = get_trs_stats(trs).supply;
+
+    //perform 1tokensquare1v final sqrt()
+    //NOTE: lightballots will already have sqrt() applied
+    if (bal.voting_method == name("1tsquare1v") && !bal.settings.at(name("lightballot"))) {
+        map<name, asset> squared_options = bal.options;
+
+        //square root total votes on each option
+        for (auto i = squared_options.begin(); i != squared_options.end(); i++) {
+            squared_options[i->first] = asset(sqrtl(i->second.amount), bal.treasury_symbol);
+        }
+
+        //update vote counts
+        ballots.modify(bal, same_payer, [&](auto& col) {
+            col.options = squared_options;
+        });
+    }
+
+    //write final results
+    write_results(bal, supply, ram_payer);
+
+    //if broadcast true, send broadcast inline to self
+    if (broadcast) {
+        broadcast_action broadcast_act(get_self(), { get_self(), active_permission });
+        broadcast_act.send(bal.ballot_name, bal.options, bal.total_voters);
+    }
+
+}
+
+void decide::write_results(const ballot& bal, asset supply, name ram_payer) {
+
+    //initialize
+    vector<ranked_option> ranked;
+    uint128_t total_votes = 0;
+
+    for (auto i = bal.options.begin(); i != bal.options.end(); i++) {
+        ranked.push_back(ranked_option{i->first, i->second, 0});
+        total_votes += uint128_t(i->second.amount);
+    }
+
+    //rank by votes, ties ordered by option name
+    std::stable_sort(ranked.begin(), ranked.end(), [](const ranked_option& a, const ranked_option& b) {
+        return a.votes.amount > b.votes.amount;
+    });
+
+    //calculate option shares and winners
+    //multi-winner ballots take top options with votes, ties at the cutoff go to the lower option name
+    vector<name> winners;
+    uint8_t winner_count = bal.winners.value_or(1);
+    for (auto& opt : ranked) {
+        if (total_votes > 0) {
+            opt.bps = uint16_t(uint128_t(opt.votes.amount) * 10000 / total_votes);
+        }
+        if (opt.votes.amount > 0) {
+            if (winner_count > 1 && winners.size() < winner_count) {
+                winners.push_back(opt.option_name);
+            } else if (winner_count == 1 && opt.votes == ranked.front().votes) {
+                winners.push_back(opt.option_name);
+            }
+        }
+    }
+
+    //calculate turnout, capped at 100%
+    uint16_t turnout_bps = 0;
+    if (supply.amount > 0 && bal.total_raw_weight.amount > 0) {
+        turnout_bps = uint16_t(std::min(uint128_t(bal.total_raw_weight.amount) * 10000 / uint128_t(supply.amount), uint128_t(10000)));
+    }
+
+    //open results table, search for result
+    results_table results(get_self(), get_self().value);
+    auto res_itr = results.find(bal.ballot_name.value);
+
+    //validate
+    check(res_itr == results.end(), "ballot results already written");
+
+    //emplace results
+    results.emplace(ram_payer, [&](auto& col) {
+        col.ballot_name = bal.ballot_name;
+        col.treasury_symbol = bal.treasury_symbol;
+        col.ranked_options = ranked;
+        col.winners = winners;
+        col.total_raw_weight = bal.total_raw_weight;
+        col.total_voters = bal.total_voters;
+        col.turnout_bps = turnout_bps;
+        col.close_time = time_point_sec(current_time_point());
+    });
+
+}
+
+void decide::release_archive(ballots_table& ballots, name ballot_name) {
+
+    //search for ballot
+    auto bal_itr = ballots.find(ballot_name.value);
+
+    //change ballot status to closed
+    if (bal_itr != ballots.end()) {
+        ballots.modify(bal_itr, same_payer, [&](auto& col) {
+            col.status = name("closed");
+        });
+        sync_ballot_index(*bal_itr);
+        return;
+    }
+
+    //open digests table, get digest
+    digests_table digests(get_self(), get_self().value);
+    auto& dig = digests.get(ballot_name.value, "digest not found");
+
+    //open results table, search for results
+    results_table results(get_self(), get_self().value);
+    auto res_itr = results.find(ballot_name.value);
+
+    //erase results
+    if (res_itr != results.end()) {
+        results.erase(res_itr);
+    }
+
+    //erase digest
+    digests.erase(dig);
+
+}
+
+void decide::add_ballot_index(const ballot& bal, name payer) {
+
+    //open ballot index table
+    ballotidx_table ballotidx(get_self(), get_self().value);
+
+    //emplace ballot index
+    ballotidx.emplace(payer, [&](auto& col) {
+        col.ballot_name = bal.ballot_name;
+        col.treasury_symbol = bal.treasury_symbol;
+        col.status = bal.status;
+        col.publisher = bal.publisher;
+        col.begin_time = bal.begin_time;
+        col.end_time = bal.end_time;
+    });
+
+}
+
+void decide::sync_ballot_index(const ballot& bal) {
+
+    //open ballot index table, search for ballot index
+    ballotidx_table ballotidx(get_self(), get_self().value);
+    auto idx_itr = ballotidx.find(bal.ballot_name.value);
+
+    //NOTE: ballots created before indexing are added by indexballots
+    if (idx_itr != ballotidx.end()) {
+        ballotidx.modify(idx_itr, same_payer, [&](auto& col) {
+            col.status = bal.status;
+            col.begin_time = bal.begin_time;
+            col.end_time = bal.end_time;
+        });
+    }
+
+}
+
+void decide::erase_ballot_index(name ballot_name) {
+
+    //open ballot index table, search for ballot index
+    ballotidx_table ballotidx(get_self(), get_self().value);
+    auto idx_itr = ballotidx.find(ballot_name.value);
+
+    //erase ballot index
+    if (idx_itr != ballotidx.end()) {
+        ballotidx.erase(idx_itr);
+    }
+
+}
+
+checksum256 decide::add_blob_ref(const string& data, name publisher) {
+
+    //hash data
+    checksum256 hash = sha256(data.c_str(), data.size());
+    uint64_t blob_id = get_blob_id(hash);
+
+    //open blobs table, search for blob
+    blobs_table blobs(get_self(), publisher.value);
+    auto b_itr = blobs.find(blob_id);
+
+    if (b_itr == blobs.end()) {
+        //emplace new blob
+        blobs.emplace(publisher, [&](auto& col) {
+            col.blob_id = blob_id;
+            col.hash = hash;
+            col.data = data;
+            col.refs = 1;
+        });
+    } else {
+        //validate
+        check(b_itr->hash == hash, "blob id collision");
+
+        //add reference to existing blob
+        blobs.modify(b_itr, same_payer, [&](auto& col) {
+            col.refs += 1;
+        });
+    }
+
+    return hash;
+}
+
+void decide::release_blob_ref(const checksum256& hash, name publisher) {
+
+    //open blobs table, get blob
+    blobs_table blobs(get_self(), publisher.value);
+    auto& b = blobs.get(get_blob_id(hash), "blob not found");
+
+    //erase blob if last reference, otherwise remove reference
+    if (b.refs <= 1) {
+        blobs.erase(b);
+    } else {
+        blobs.modify(b, same_payer, [&](auto& col) {
+            col.refs -= 1;
+        });
+    }
+
+}
+
+void decide::store_details(name ballot_name, name payer, string& description, string& content) {
+
+    //initialize
+    checksum256 description_hash = checksum256();
+    checksum256 content_hash = checksum256();
+
+    //move large details to blobs
+    //NOTE: new references are added before old ones are released so unchanged blobs aren't recreated
+    if (description.size() >= blob_min_size) {
+        description_hash = add_blob_ref(description, payer);
+        description = "";
+    }
+
+    if (content.size() >= blob_min_size) {
+        content_hash = add_blob_ref(content, payer);
+        content = "";
+    }
+
+    //release previous blob references
+    release_details(ballot_name);
+
+    //emplace new metaref if any details are blobs
+    if (description_hash != checksum256() || content_hash != checksum256()) {
+        metarefs_table metarefs(get_self(), get_self().value);
+
+        metarefs.emplace(payer, [&](auto& col) {
+            col.ballot_name = ballot_name;
+            col.publisher = payer;
+            col.description_hash = description_hash;
+            col.content_hash = content_hash;
+        });
+    }
+
+}
+
+void decide::release_details(name ballot_name) {
+
+    //open compressed details table, search for compressed details
+    zdetails_table zdetails(get_self(), get_self().value);
+    auto zd_itr = zdetails.find(ballot_name.value);
+
+    //erase compressed details
+    if (zd_itr != zdetails.end()) {
+        zdetails.erase(zd_itr);
+    }
+
+    //open metarefs table, search for metaref
+    metarefs_table metarefs(get_self(), get_self().value);
+    auto mr_itr = metarefs.find(ballot_name.value);
+
+    //return if ballot has no blobs
+    if (mr_itr == metarefs.end()) {
+        return;
+    }
+
+    //release blob references
+    if (mr_itr->description_hash != checksum256()) {
+        release_blob_ref(mr_itr->description_hash, mr_itr->publisher);
+    }
+
+    if (mr_itr->content_hash != checksum256()) {
+        release_blob_ref(mr_itr->content_hash, mr_itr->publisher);
+    }
+
+    //erase metaref
+    metarefs.erase(mr_itr);
+
+}
+
+void decide::resolve_details(name ballot_name, string& description, string& content) {
+
+    //open compressed details table, search for compressed details
+    zdetails_table zdetails(get_self(), get_self().value);
+    auto zd_itr = zdetails.find(ballot_name.value);
+
+    //NOTE: compressed details resolve to their bytes as submitted
+    if (zd_itr != zdetails.end()) {
+        if (!zd_itr->description.empty()) {
+            description = string(zd_itr->description.begin(), zd_itr->description.end());
+        }
+
+        if (!zd_itr->content.empty()) {
+            content = string(zd_itr->content.begin(), zd_itr->content.end());
+        }
+    }
+
+    //open metarefs table, search for metaref
+    metarefs_table metarefs(get_self(), get_self().value);
+    auto mr_itr = metarefs.find(ballot_name.value);
+
+    //return if ballot has no blobs
+    if (mr_itr == metarefs.end()) {
+        return;
+    }
+
+    //open blobs table
+    blobs_table blobs(get_self(), mr_itr->publisher.value);
+
+    //read blob data
+    if (mr_itr->description_hash != checksum256()) {
+        description = blobs.get(get_blob_id(mr_itr->description_hash), "blob not found").data;
+    }
+
+    if (mr_itr->content_hash != checksum256()) {
+        content = blobs.get(get_blob_id(mr_itr->content_hash), "blob not found").data;
+    }
+
+}
+
+void decide::clear_subscribers(name ballot_name) {
+
+    //open subscribers table
+    subscribers_table subscribers(get_self(), ballot_name.value);
+
+    //erase subscribers, bounded by max subscribers
+    auto sub_itr = subscribers.begin();
+    while (sub_itr != subscribers.end()) {
+        sub_itr = subscribers.erase(sub_itr);
+    }
+
+}
@@ -80,6 +80,9 @@ ACTION decide::removeseat(name committee_name, symbol treasury_symbol, name seat
     //validate
     check(cmt.seats.find(seat_name) != cmt.seats.end(), "seat name not found");
 
+    //remove seat from holder's held seats
+    remove_held_seat(cmt.seats.at(seat_name), treasury_symbol, committee_name, seat_name);
+
     //remove seat from committee
     committees.modify(cmt, same_payer, [&](auto& col) {
         col.seats.erase(seat_name);
@@ -99,6 +102,10 @@ ACTION decide::assignseat(name committee_name, symbol treasury_symbol, name seat
     //validate
     check(cmt.seats.find(seat_name) != cmt.seats.end(), "seat name not found");
 
+    //move seat from old holder to new holder
+    remove_held_seat(cmt.seats.at(seat_name), treasury_symbol, committee_name, seat_name);
+    add_held_seat(seat_holder, treasury_symbol, committee_name, seat_name, cmt.updater_acct);
+
     //assign seat holder to seat on committee
     committees.modify(cmt, same_payer, [&](auto& col) {
         col.seats[seat_name] = seat_holder;
@@ -106,6 +113,90 @@ ACTION decide::assignseat(name committee_name, symbol treasury_symbol, name seat
 
 }
 
+ACTION decide::assignseats(name committee_name, symbol treasury_symbol, vector<pair<name, name>> assignments, string memo) {
+
+    //open committees table, get committee
+    committees_table committees(get_self(), treasury_symbol.code().raw());
+    auto& cmt = committees.get(committee_name.value, "committee not found");
+    
+    //authenticate
+    require_auth(permission_level{cmt.updater_acct, cmt.updater_auth});
+
+    //validate
+    check(assignments.size() > 0, "must assign at least one seat");
+
+    //initialize
+    map<name, name> new_seats = cmt.seats;
+    map<name, bool> assigned;
+
+    for (auto& a : assignments) {
+        //validate
+        check(new_seats.find(a.first) != new_seats.end(), "seat name not found");
+        check(assigned.find(a.first) == assigned.end(), "seat assigned more than once");
+
+        //move seat from old holder to new holder
+        remove_held_seat(new_seats[a.first], treasury_symbol, committee_name, a.first);
+        add_held_seat(a.second, treasury_symbol, committee_name, a.first, cmt.updater_acct);
+
+        //assign seat holder to seat
+        new_seats[a.first] = a.second;
+        assigned[a.first] = true;
+    }
+
+    //update committee seats
+    committees.modify(cmt, same_payer, [&](auto& col) {
+        col.seats = new_seats;
+    });
+
+}
+
+ACTION decide::vacateseats(name committee_name, symbol treasury_symbol, vector<name> seat_names, string memo) {
+
+    //open committees table, get committee
+    committees_table committees(get_self(), treasury_symbol.code().raw());
+    auto& cmt = committees.get(committee_name.value, "committee not found");
+    
+    //authenticate
+    require_auth(permission_level{cmt.updater_acct, cmt.updater_auth});
+
+    //validate
+    check(seat_names.size() > 0, "must vacate at least one seat");
+
+    //initialize
+    map<name, name> new_seats = cmt.seats;
+
+    for (name n : seat_names) {
+        //validate
+        check(new_seats.find(n) != new_seats.end(), "seat name not found");
+
+        //vacate seat
+        remove_held_seat(new_seats[n], treasury_symbol, committee_name, n);
+        new_seats[n] = name(0);
+    }
+
+    //update committee seats
+    committees.modify(cmt, same_payer, [&](auto& col) {
+        col.seats = new_seats;
+    });
+
+}
+
+ACTION decide::syncseats(name committee_name, symbol treasury_symbol) {
+
+    //open committees table, get committee
+    committees_table committees(get_self(), treasury_symbol.code().raw());
+    auto& cmt = committees.get(committee_name.value, "committee not found");
+    
+    //authenticate
+    require_auth(permission_level{cmt.updater_acct, cmt.updater_auth});
+
+    //add each seat to holder's held seats
+    for (auto& s : cmt.seats) {
+        add_held_seat(s.second, treasury_symbol, committee_name, s.first, cmt.updater_acct);
+    }
+
+}
+
 ACTION decide::setupdater(name committee_name, symbol treasury_symbol, name updater_account, name updater_auth) {
 
     //open committees table, get committee
@@ -133,7 +224,77 @@ ACTION decide::delcommittee(name committee_name, symbol treasury_symbol, string
     //authenticate
     require_auth(permission_level{cmt.updater_acct, cmt.updater_auth});
 
+    //remove seats from holders' held seats
+    for (auto& s : cmt.seats) {
+        remove_held_seat(s.second, treasury_symbol, committee_name, s.first);
+    }
+
     //erase committee
     committees.erase(cmt);
 
-}
\ No newline at end of file
+}
+
+//======================== committee helpers ========================
+
+void decide::add_held_seat(name holder, symbol treasury_symbol, name committee_name, name seat_name, name ram_payer) {
+
+    //empty seats aren't held
+    if (holder == name(0)) {
+        return;
+    }
+
+    //open held seats table, search for held seats
+    heldseats_table heldseats(get_self(), holder.value);
+    auto hs_itr = heldseats.find(treasury_symbol.code().raw());
+    pair<name, name> seat = { committee_name, seat_name };
+
+    if (hs_itr == heldseats.end()) {
+        //emplace new held seats
+        heldseats.emplace(ram_payer, [&](auto& col) {
+            col.treasury_symbol = treasury_symbol;
+            col.seats = { seat };
+        });
+    } else if (std::find(hs_itr->seats.begin(), hs_itr->seats.end(), seat) == hs_itr->seats.end()) {
+        //add seat to held seats
+        heldseats.modify(hs_itr, ram_payer, [&](auto& col) {
+            col.seats.push_back(seat);
+        });
+    }
+
+}
+
+void decide::remove_held_seat(name holder, symbol treasury_symbol, name committee_name, name seat_name) {
+
+    //empty seats aren't held
+    if (holder == name(0)) {
+        return;
+    }
+
+    //open held seats table, search for held seats
+    heldseats_table heldseats(get_self(), holder.value);
+    auto hs_itr = heldseats.find(treasury_symbol.code().raw());
+
+    //seats assigned before held seats were indexed may not be found
+    if (hs_itr == heldseats.end()) {
+        return;
+    }
+
+    //initialize
+    pair<name, name> seat = { committee_name, seat_name };
+    auto s_itr = std::find(hs_itr->seats.begin(), hs_itr->seats.end(), seat);
+
+    if (s_itr == hs_itr->seats.end()) {
+        return;
+    }
+
+    if (hs_itr->seats.size() == 1) {
+        //erase held seats
+        heldseats.erase(hs_itr);
+    } else {
+        //remove seat from held seats
+        heldseats.modify(hs_itr, same_payer, [&](auto& col) {
+            col.seats.erase(std::find(col.seats.begin(), col.seats.end(), seat));
+        });
+    }
+
+}
@@ -29,12 +29,15 @@ ACTION decide::init(string app_version) {
     new_fees[name("ballot")] = asset(100000, TLOS_SYM); //10 TLOS
     new_fees[name("treasury")] = asset(5000000, TLOS_SYM); //500 TLOS
     new_fees[name("archival")] = asset(10000, TLOS_SYM); //1 TLOS (per day)
+    new_fees[name("digestarch")] = asset(1000, TLOS_SYM); //0.1 TLOS (per day)
     new_fees[name("committee")] = asset(100000, TLOS_SYM); //100 TLOS
 
     //set default times
     new_times[name("minballength")] = uint32_t(60); //1 minute in seconds
     new_times[name("balcooldown")] = uint32_t(86400); //1 day in seconds
     new_times[name("forfeittime")] = uint32_t(864000); //10 days in seconds
+    new_times[name("chkptwindow")] = uint32_t(2592000); //30 days in seconds
+    new_times[name("closegrace")] = uint32_t(86400); //1 day in seconds
 
     //build new configs
     config new_config = {
@@ -114,6 +117,22 @@ ACTION decide::updatetime(name time_name, uint32_t length) {
 
 }
 
+ACTION decide::setchainid(checksum256 chain_id) {
+    
+    //authenticate
+    require_auth(get_self());
+
+    //validate
+    check(chain_id != checksum256(), "chain id cannot be empty");
+
+    //open sign domain singleton
+    signdomain_singleton signdomain(get_self(), get_self().value);
+
+    //set chain id
+    signdomain.set(sign_domain{chain_id}, get_self());
+
+}
+
 ACTION decide::withdraw(name voter, asset quantity) {
     
     //authenticate
@@ -216,15 +235,49 @@ void decide::catch_transfer(name from, name to, asset quantity, string memo) {
 
 //========== utility methods ==========
 
-void decide::add_liquid(name voter, asset quantity) {
-    //open voters table, get voter
+bool decide::add_liquid(name voter, asset quantity, name sender) {
+    //open voters table, search for voter
     voters_table to_voters(get_self(), voter.value);
-    auto& to_voter = to_voters.get(quantity.symbol.code().raw(), "add_liquid: voter not found");
+    auto vtr_itr = to_voters.find(quantity.symbol.code().raw());
+
+    //initialize
+    bool new_voter = false;
+
+    //create voter on first credit from a public treasury
+    if (vtr_itr == to_voters.end() && sender != name(0) && quantity.symbol != VOTE_SYM && quantity.symbol != TLOS_SYM) {
+        
+        //open treasuries table, get treasury
+        treasuries_table treasuries(get_self(), get_self().value);
+        auto& trs = treasuries.get(quantity.symbol.code().raw(), "treasury not found");
+
+        if (trs.access == name("public")) {
+            
+            //initialize
+            name ram_payer = setting_enabled(trs.settings, name("mgrpaysram")) ? trs.manager : sender;
+
+            //validate
+            check(has_auth(ram_payer), "new voter ram payer must authorize");
+
+            //emplace new voter
+            add_voter(to_voters, voter, quantity.symbol, ram_payer);
+            vtr_itr = to_voters.find(quantity.symbol.code().raw());
+            new_voter = true;
+        }
+    }
+
+    //validate
+    check(vtr_itr != to_voters.end(), "add_liquid: voter not found");
+    auto& to_voter = *vtr_itr;
 
     //add quantity to liquid
     to_voters.modify(to_voter, same_payer, [&](auto& col) {
         col.liquid += quantity;
     });
+
+    //log new balance
+    log_checkpoint(voter, to_voter.liquid - quantity, to_voter.staked, to_voter.liquid, to_voter.staked);
+
+    return new_voter;
 }
 
 void decide::sub_liquid(name voter, asset quantity) {
@@ -239,6 +292,9 @@ void decide::sub_liquid(name voter, asset quantity) {
     from_voters.modify(from_voter, same_payer, [&](auto& col) {
         col.liquid -= quantity;
     });
+
+    //log new balance
+    log_checkpoint(voter, from_voter.liquid + quantity, from_voter.staked, from_voter.liquid, from_voter.staked);
 }
 
 void decide::add_stake(name voter, asset quantity) {
@@ -246,11 +302,20 @@ void decide::add_stake(name voter, asset quantity) {
     voters_table to_voters(get_self(), voter.value);
     auto& to_voter = to_voters.get(quantity.symbol.code().raw(), "add_stake: voter not found");
 
-    //add quantity to stake
+    //add quantity to stake, delegated stake follows staked balance
     to_voters.modify(to_voter, same_payer, [&](auto& col) {
         col.staked += quantity;
         col.staked_time = time_point_sec(current_time_point());
+        if (col.delegated_to != name(0)) {
+            col.delegated += quantity;
+        }
     });
+
+    //update delegate
+    update_delegate(to_voter.delegated_to, quantity);
+
+    //log new balance
+    log_checkpoint(voter, to_voter.liquid, to_voter.staked - quantity, to_voter.liquid, to_voter.staked);
 }
 
 void decide::sub_stake(name voter, asset quantity) {
@@ -261,13 +326,285 @@ void decide::sub_stake(name voter, asset quantity) {
     //validate
     check(from_voter.staked >= quantity, "insufficient staked amount");
 
-    //subtract quantity from stake
+    //subtract quantity from stake, delegated stake follows staked balance
     from_voters.modify(from_voter, same_payer, [&](auto& col) {
         col.staked -= quantity;
         col.staked_time = time_point_sec(current_time_point());
+        if (col.delegated_to != name(0)) {
+            col.delegated -= quantity;
+        }
+    });
+
+    //update delegate
+    update_delegate(from_voter.delegated_to, -quantity);
+
+    //log new balance
+    log_checkpoint(voter, from_voter.liquid, from_voter.staked + quantity, from_voter.liquid, from_voter.staked);
+}
+
+void decide::update_delegate(name delegate_name, asset delta) {
+    //return if not delegated or no change
+    if (delegate_name == name(0) || delta.amount == 0) {
+        return;
+    }
+
+    //open delegates table, get delegate
+    delegates_table delegates(get_self(), delta.symbol.code().raw());
+    auto& del = delegates.get(delegate_name.value, "update_delegate: delegate not found");
+
+    //apply delta to total delegated
+    delegates.modify(del, same_payer, [&](auto& col) {
+        col.total_delegated += delta;
     });
 }
 
+asset decide::get_delegated_weight(name delegate_name, symbol treasury_symbol) {
+    //open delegates table, search for delegate
+    delegates_table delegates(get_self(), treasury_symbol.code().raw());
+    auto del_itr = delegates.find(delegate_name.value);
+
+    return del_itr == delegates.end() ? asset(0, treasury_symbol) : del_itr->total_delegated;
+}
+
+void decide::log_checkpoint(name voter, asset prev_liquid, asset prev_staked, asset new_liquid, asset new_staked) {
+    //get treasury snapshot times
+    auto snap = get_snapshot(new_liquid.symbol);
+
+    //return if treasury has never had a snapshot ballot
+    if (snap.last_snapshot == time_point_sec(0)) {
+        return;
+    }
+
+    //initialize
+    auto now = time_point_sec(current_time_point());
+    uint32_t window = get_checkpoint_window();
+
+    //return if no snapshot ballot can still be open
+    //NOTE: snapshot ballots can't be open longer than the checkpoint window
+    if (snap.last_snapshot.sec_since_epoch() + window < now.sec_since_epoch()) {
+        return;
+    }
+
+    //open balance history table, search for history
+    balhistory_table balhistory(get_self(), voter.value);
+    auto hist_itr = balhistory.find(new_liquid.symbol.code().raw());
+
+    //initialize
+    checkpoint new_checkpoint = { now, new_liquid.amount, new_staked.amount };
+
+    //emplace history if not found, reseed if stale, update otherwise
+    if (hist_itr == balhistory.end()) {
+        
+        //seed history with balance held before first checkpoint
+        vector<checkpoint> new_checkpoints;
+        new_checkpoints.push_back({ time_point_sec(0), prev_liquid.amount, prev_staked.amount });
+        new_checkpoints.push_back(new_checkpoint);
+
+        balhistory.emplace(get_self(), [&](auto& col) {
+            col.treasury_symbol = new_liquid.symbol;
+            col.checkpoints = new_checkpoints;
+        });
+
+    } else if (hist_itr->checkpoints.back().checkpoint_time < snap.active_since) {
+
+        //history missed changes made while no snapshot ballot was open, reseed with balance held since
+        balhistory.modify(*hist_itr, same_payer, [&](auto& col) {
+            col.checkpoints.clear();
+            col.checkpoints.push_back({ time_point_sec(0), prev_liquid.amount, prev_staked.amount });
+            col.checkpoints.push_back(new_checkpoint);
+        });
+
+    } else {
+
+        //initialize
+        uint32_t cutoff = now.sec_since_epoch() > window ? now.sec_since_epoch() - window : 0;
+        auto last_snapshot = snap.last_snapshot;
+
+        //last checkpoint can be merged if no snapshot ballot could have read it
+        balhistory.modify(*hist_itr, same_payer, [&](auto& col) {
+            
+            //overwrite if balance already changed this second or no snapshot began since, append otherwise
+            //NOTE: bounds contract paid history by snapshot ballots opened instead of balance changes
+            auto last_time = col.checkpoints.back().checkpoint_time;
+            if (col.checkpoints.size() > 1 && (last_time == now || last_time > last_snapshot)) {
+                col.checkpoints.back() = new_checkpoint;
+            } else {
+                col.checkpoints.push_back(new_checkpoint);
+            }
+
+            //prune checkpoints superseded before the cutoff (keeps latest checkpoint at or before cutoff)
+            size_t stale = 0;
+            while (stale + 1 < col.checkpoints.size() && col.checkpoints[stale + 1].checkpoint_time.sec_since_epoch() <= cutoff) {
+                stale++;
+            }
+            col.checkpoints.erase(col.checkpoints.begin(), col.checkpoints.begin() + stale);
+        });
+
+    }
+}
+
+asset decide::get_snapshot_weight(name voter, asset current_weight, time_point_sec snapshot_time, bool use_stake) {
+    //open balance history table, search for history
+    balhistory_table balhistory(get_self(), voter.value);
+    auto hist_itr = balhistory.find(current_weight.symbol.code().raw());
+
+    //no history means balance hasn't changed since before checkpoints were logged
+    if (hist_itr == balhistory.end()) {
+        return current_weight;
+    }
+
+    //stale history means balance hasn't changed since snapshots became active
+    if (hist_itr->checkpoints.back().checkpoint_time < get_snapshot(current_weight.symbol).active_since) {
+        return current_weight;
+    }
+
+    //find last checkpoint at or before snapshot time
+    auto& checkpoints = hist_itr->checkpoints;
+    auto cp_itr = upper_bound(checkpoints.begin(), checkpoints.end(), snapshot_time, 
+        [](const time_point_sec& t, const checkpoint& cp) { return t < cp.checkpoint_time; });
+
+    //validate
+    check(cp_itr != checkpoints.begin(), "snapshot time predates balance history");
+
+    cp_itr--;
+
+    return asset(use_stake ? cp_itr->staked : cp_itr->liquid, current_weight.symbol);
+}
+
+void decide::log_snapshot(symbol treasury_symbol, time_point_sec snapshot_time, name ram_payer) {
+    //open snapshots table, search for snapshot
+    snapshots_table snapshots(get_self(), get_self().value);
+    auto snap_itr = snapshots.find(treasury_symbol.code().raw());
+
+    //emplace snapshot if not found, update if exists
+    if (snap_itr == snapshots.end()) {
+        snapshots.emplace(ram_payer, [&](auto& col) {
+            col.treasury_symbol = treasury_symbol;
+            col.last_snapshot = snapshot_time;
+            col.active_since = snapshot_time;
+        });
+    } else {
+        //history stopped being logged if previous snapshot left the checkpoint window
+        bool lapsed = snap_itr->last_snapshot.sec_since_epoch() + get_checkpoint_window() < snapshot_time.sec_since_epoch();
+
+        snapshots.modify(snap_itr, same_payer, [&](auto& col) {
+            col.last_snapshot = snapshot_time;
+            if (lapsed) {
+                col.active_since = snapshot_time;
+            }
+        });
+    }
+}
+
+decide::treasury_snapshot decide::get_snapshot(symbol treasury_symbol) {
+    //open snapshots table, search for snapshot
+    snapshots_table snapshots(get_self(), get_self().value);
+    auto snap_itr = snapshots.find(treasury_symbol.code().raw());
+
+    return snap_itr == snapshots.end() ? treasury_snapshot{ treasury_symbol, time_point_sec(0), time_point_sec(0) } : *snap_itr;
+}
+
+uint32_t decide::get_checkpoint_window() {
+    return get_config_time(name("chkptwindow"), uint32_t(2592000));
+}
+
+uint32_t decide::get_config_time(name time_name, uint32_t default_length) {
+    //open config singleton, get config
+    config_singleton configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //NOTE: configs initialized before a time was added won't have it
+    auto t_itr = conf.times.find(time_name);
+    return t_itr != conf.times.end() ? t_itr->second : default_length;
+}
+
+asset decide::get_config_fee(name fee_name, asset default_fee) {
+    //open config singleton, get config
+    config_singleton configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //NOTE: configs initialized before a fee was added won't have it
+    auto f_itr = conf.fees.find(fee_name);
+    return f_itr != conf.fees.end() ? f_itr->second : default_fee;
+}
+
+void decide::validate_packed_detail(const vector<char>& detail) {
+    //empty details aren't compressed
+    if (detail.empty()) {
+        return;
+    }
+
+    //read original size
+    uint32_t original_size = 0;
+    if (detail.size() > detail_header_size) {
+        for (int i = 0; i < 4; i++) {
+            original_size |= uint32_t(uint8_t(detail[3 + i])) << (8 * i);
+        }
+    }
+
+    //validate
+    //NOTE: payload isn't decompressed on chain, clients decode it
+    check(detail.size() > detail_header_size, "compressed detail is too short");
+    check(detail[0] == 'D' && detail[1] == 'Z', "invalid compressed detail header");
+    check(uint8_t(detail[2]) == detail_codec_lz4, "unsupported detail codec");
+    check(original_size > 0 && original_size <= max_detail_size, "invalid compressed detail original size");
+    check(detail.size() < original_size, "compressed detail must be smaller than original");
+}
+
+uint64_t decide::get_blob_id(const checksum256& hash) {
+    auto hash_bytes = hash.extract_as_byte_array();
+    uint64_t blob_id;
+    memcpy(&blob_id, hash_bytes.data(), sizeof(blob_id));
+    return blob_id;
+}
+
+bool decide::setting_enabled(const map<name, bool>& settings, name setting_name) {
+    auto set_itr = settings.find(setting_name);
+    return set_itr != settings.end() && set_itr->second;
+}
+
+bool decide::verify_merkle_proof(checksum256 merkle_root, name account, asset weight, const vector<checksum256>& proof) {
+    
+    //initialize
+    uint64_t account_value = account.value;
+    int64_t weight_amount = weight.amount;
+
+    //leaf hash: sha256(0x00 || account || weight amount)
+    char leaf_data[17];
+    leaf_data[0] = 0x00;
+    memcpy(leaf_data + 1, &account_value, 8);
+    memcpy(leaf_data + 9, &weight_amount, 8);
+    checksum256 node = sha256(leaf_data, sizeof(leaf_data));
+
+    //node hash: sha256(0x01 || lesser child || greater child)
+    char node_data[65];
+    node_data[0] = 0x01;
+
+    for (const auto& sibling : proof) {
+        auto lhs = node.extract_as_byte_array();
+        auto rhs = sibling.extract_as_byte_array();
+
+        //order children so proofs don't need positions
+        if (rhs < lhs) {
+            swap(lhs, rhs);
+        }
+
+        memcpy(node_data + 1, lhs.data(), 32);
+        memcpy(node_data + 33, rhs.data(), 32);
+        node = sha256(node_data, sizeof(node_data));
+    }
+
+    return node == merkle_root;
+}
+
+checksum256 decide::get_vote_digest(checksum256 chain_id, const signed_vote& vote) {
+
+    //pack message domain and vote contents
+    auto packed = pack(std::make_tuple(chain_id, get_self(), vote.voter, vote.ballot_name, vote.options, vote.nonce));
+
+    return sha256(packed.data(), packed.size());
+}
+
 bool decide::valid_category(name category) {
     switch (category.value) {
         case (name("proposal").value):
@@ -321,6 +658,43 @@ bool decide::valid_access_method(name access_method) {
     }
 }
 
+bool decide::valid_notify_policy(name policy) {
+    switch (policy.value) {
+        case (name("always").value):
+            return true;
+        case (name("never").value):
+            return true;
+        case (name("optin").value):
+            return true;
+        default:
+            return false;
+    }
+}
+
+void decide::notify_holders(symbol treasury_symbol, vector<name> accounts) {
+    //open notify policies table, search for policy
+    notifypolicy_table notifypolicies(get_self(), get_self().value);
+    auto np_itr = notifypolicies.find(treasury_symbol.code().raw());
+
+    //notify all accounts if no policy
+    if (np_itr == notifypolicies.end()) {
+        for (name a : accounts) {
+            require_recipient(a);
+        }
+        return;
+    }
+
+    //notify opted in accounts
+    if (np_itr->policy == name("optin")) {
+        for (name a : accounts) {
+            notifyoptins_table notifyoptins(get_self(), a.value);
+            if (notifyoptins.find(treasury_symbol.code().raw()) != notifyoptins.end()) {
+                require_recipient(a);
+            }
+        }
+    }
+}
+
 void decide::require_fee(name account_name, asset fee) {
     //open accounts table, get TLOS balance
     accounts_table tlos_accounts(get_self(), account_name.value);
@@ -376,14 +750,21 @@ void decide::sync_external_account(name voter, symbol internal_symbol, symbol ex
         asset delta = asset(tlos_stake.amount - vtr_itr->staked.amount, internal_symbol);
 
         //apply delta to supply
-        treasuries.modify(*trs_itr, same_payer, [&](auto& col) {
-            col.supply += asset(delta.amount, internal_symbol);
-        });
+        update_trs_stats(*trs_itr, delta.amount, 0, 0, 0);
 
-        //mirror tlos_stake to internal_symbol stake
+        //mirror tlos_stake to internal_symbol stake, delegated stake follows staked balance
         voters.modify(*vtr_itr, same_payer, [&](auto& col) {
             col.staked = asset(tlos_stake.amount, internal_symbol);
+            if (col.delegated_to != name(0)) {
+                col.delegated = col.staked;
+            }
         });
 
+        //update delegate
+        update_delegate(vtr_itr->delegated_to, delta);
+
+        //log new balance
+        log_checkpoint(voter, vtr_itr->liquid, vtr_itr->staked - delta, vtr_itr->liquid, vtr_itr->staked);
+
     }
 }
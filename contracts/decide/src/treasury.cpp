@@ -40,6 +40,7 @@ ACTION decide::newtreasury(name manager, asset max_supply, name access) {
     initial_settings[name("stakeable")] = false;
     initial_settings[name("unstakeable")] = false;
     initial_settings[name("maxmutable")] = false;
+    initial_settings[name("mgrpaysram")] = false;
 
     //emplace new token treasury, RAM paid by manager
     treasuries.emplace(manager, [&](auto& col) {
@@ -60,6 +61,16 @@ ACTION decide::newtreasury(name manager, asset max_supply, name access) {
         col.settings = initial_settings;
     });
 
+    //emplace treasury stats, RAM paid by manager
+    trsstats_table trsstats(get_self(), get_self().value);
+    trsstats.emplace(manager, [&](auto& col) {
+        col.supply = asset(0, max_supply.symbol);
+        col.voters = uint32_t(0);
+        col.delegates = uint32_t(0);
+        col.committees = uint32_t(0);
+        col.open_ballots = uint32_t(0);
+    });
+
     //open payrolls table, find worker payroll
     payrolls_table payrolls(get_self(), max_supply.symbol.code().raw());
     auto pr = payrolls.find(name("workers").value);
@@ -131,11 +142,12 @@ ACTION decide::toggle(symbol treasury_symbol, name setting_name) {
     //validate
     check(!trs.locked, "treasury is locked");
     auto set_itr = trs.settings.find(setting_name);
-    check(set_itr != trs.settings.end(), "setting not found");
+    //treasuries created before mgrpaysram was added don't have the setting
+    check(set_itr != trs.settings.end() || setting_name == name("mgrpaysram"), "setting not found");
 
     //update setting
     treasuries.modify(trs, same_payer, [&](auto& col) {
-        col.settings[setting_name] = !trs.settings.at(setting_name);
+        col.settings[setting_name] = !setting_enabled(trs.settings, setting_name);
     });
 
 }
@@ -151,21 +163,19 @@ ACTION decide::mint(name to, asset quantity, string memo) {
 
     //validate
     check(is_account(to), "to account doesn't exist");
-    check(trs.supply + quantity <= trs.max_supply, "minting would breach max supply");
+    check(get_trs_stats(trs).supply + quantity <= trs.max_supply, "minting would breach max supply");
     check(quantity.amount > 0, "must mint a positive quantity");
     check(quantity.is_valid(), "invalid quantity");
     check(memo.size() <= 256, "memo has more than 256 bytes");
 
     //update recipient liquid amount
-    add_liquid(to, quantity);
+    bool new_voter = add_liquid(to, quantity, trs.manager);
 
-    //update treasury supply
-    treasuries.modify(trs, same_payer, [&](auto& col) {
-        col.supply += quantity;
-    });
+    //update treasury supply and voters
+    update_trs_stats(trs, quantity.amount, new_voter ? 1 : 0, 0, 0);
 
     //notify to account
-    require_recipient(to);
+    notify_holders(quantity.symbol, { to });
 
 }
 
@@ -190,11 +200,13 @@ ACTION decide::transfer(name from, name to, asset quantity, string memo) {
     sub_liquid(from, quantity);
 
     //add quantity to recipient liquid amount
-    add_liquid(to, quantity);
+    if (add_liquid(to, quantity, from)) {
+        //update treasury voters
+        update_trs_stats(trs, 0, 1, 0, 0);
+    }
 
     //notify from and to accounts
-    require_recipient(from);
-    require_recipient(to);
+    notify_holders(quantity.symbol, { from, to });
 
 }
 
@@ -213,7 +225,7 @@ ACTION decide::burn(asset quantity, string memo) {
 
     //validate
     check(trs.settings.at(name("burnable")), "token is not burnable");
-    check(trs.supply - quantity >= asset(0, quantity.symbol), "cannot burn supply below zero");
+    check(get_trs_stats(trs).supply - quantity >= asset(0, quantity.symbol), "cannot burn supply below zero");
     check(mgr.liquid >= quantity, "burning would overdraw balance");
     check(quantity.amount > 0, "must burn a positive quantity");
     check(quantity.is_valid(), "invalid quantity");
@@ -223,12 +235,10 @@ ACTION decide::burn(asset quantity, string memo) {
     sub_liquid(trs.manager, quantity);
 
     //update treasury supply
-    treasuries.modify(trs, same_payer, [&](auto& col) {
-        col.supply -= quantity;
-    });
+    update_trs_stats(trs, -quantity.amount, 0, 0, 0);
 
     //notify manager account
-    require_recipient(trs.manager);
+    notify_holders(quantity.symbol, { trs.manager });
 
 }
 
@@ -253,7 +263,10 @@ ACTION decide::reclaim(name voter, asset quantity, string memo) {
     sub_liquid(voter, quantity);
 
     //add quantity to manager balance
-    add_liquid(trs.manager, quantity);
+    if (add_liquid(trs.manager, quantity, trs.manager)) {
+        //update treasury voters
+        update_trs_stats(trs, 0, 1, 0, 0);
+    }
 
 }
 
@@ -270,7 +283,7 @@ ACTION decide::mutatemax(asset new_max_supply, string memo) {
     check(trs.settings.at(name("maxmutable")), "max supply is not modifiable");
     check(new_max_supply.is_valid(), "invalid amount");
     check(new_max_supply.amount >= 0, "max supply cannot be below zero");
-    check(new_max_supply >= trs.supply, "cannot lower max supply below current supply");
+    check(new_max_supply >= get_trs_stats(trs).supply, "cannot lower max supply below current supply");
     check(memo.size() <= 256, "memo has more than 256 bytes");
 
     //update max supply
@@ -337,6 +350,80 @@ ACTION decide::unlock(symbol treasury_symbol) {
 
 }
 
+ACTION decide::setnotify(symbol treasury_symbol, name policy) {
+
+    //open treasuries table, get treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(treasury_symbol.code().raw(), "treasury not found");
+
+    //authenticate
+    require_auth(trs.manager);
+
+    //validate
+    check(!trs.locked, "treasury is locked");
+    check(valid_notify_policy(policy), "invalid notify policy");
+
+    //open notify policies table, search for policy
+    notifypolicy_table notifypolicies(get_self(), get_self().value);
+    auto np_itr = notifypolicies.find(treasury_symbol.code().raw());
+
+    if (policy == name("always")) {
+        //always is the default, erase policy
+        if (np_itr != notifypolicies.end()) {
+            notifypolicies.erase(np_itr);
+        }
+    } else if (np_itr == notifypolicies.end()) {
+        //emplace new policy
+        notifypolicies.emplace(trs.manager, [&](auto& col) {
+            col.treasury_symbol = treasury_symbol;
+            col.policy = policy;
+        });
+    } else {
+        //update policy
+        notifypolicies.modify(np_itr, same_payer, [&](auto& col) {
+            col.policy = policy;
+        });
+    }
+
+}
+
+ACTION decide::optinnotify(name account, symbol treasury_symbol) {
+
+    //authenticate
+    require_auth(account);
+
+    //open treasuries table, validate treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    treasuries.get(treasury_symbol.code().raw(), "treasury not found");
+
+    //open notify optins table, search for optin
+    notifyoptins_table notifyoptins(get_self(), account.value);
+    auto no_itr = notifyoptins.find(treasury_symbol.code().raw());
+
+    //validate
+    check(no_itr == notifyoptins.end(), "account already opted in");
+
+    //emplace optin
+    notifyoptins.emplace(account, [&](auto& col) {
+        col.treasury_symbol = treasury_symbol;
+    });
+
+}
+
+ACTION decide::optoutnotify(name account, symbol treasury_symbol) {
+
+    //open notify optins table, get optin
+    notifyoptins_table notifyoptins(get_self(), account.value);
+    auto& optin = notifyoptins.get(treasury_symbol.code().raw(), "account not opted in");
+
+    //authenticate
+    require_auth(account);
+
+    //erase optin
+    notifyoptins.erase(optin);
+
+}
+
 //======================== payroll actions ========================
 
 ACTION decide::addfunds(name from, symbol treasury_symbol, asset quantity) {
@@ -389,4 +476,49 @@ ACTION decide::editpayrate(symbol treasury_symbol, uint32_t period_length, asset
         col.per_period = per_period;
     });
 
-}
\ No newline at end of file
+}
+
+//======================== treasury helpers ========================
+
+decide::treasury_stats decide::get_trs_stats(const treasury& trs) {
+
+    //open treasury stats table, search for stats
+    trsstats_table trsstats(get_self(), get_self().value);
+    auto ts_itr = trsstats.find(trs.supply.symbol.code().raw());
+
+    if (ts_itr != trsstats.end()) {
+        return *ts_itr;
+    }
+
+    //treasury counters haven't been moved to stats yet
+    return treasury_stats{ trs.supply, trs.voters, trs.delegates, trs.committees, trs.open_ballots };
+
+}
+
+void decide::update_trs_stats(const treasury& trs, int64_t supply_delta, int32_t voters_delta, 
+    int32_t delegates_delta, int32_t open_ballots_delta) {
+
+    //open treasury stats table, search for stats
+    trsstats_table trsstats(get_self(), get_self().value);
+    auto ts_itr = trsstats.find(trs.supply.symbol.code().raw());
+
+    if (ts_itr == trsstats.end()) {
+        //move counters off treasury row on first update, RAM paid by contract
+        trsstats.emplace(get_self(), [&](auto& col) {
+            col.supply = asset(trs.supply.amount + supply_delta, trs.supply.symbol);
+            col.voters = trs.voters + voters_delta;
+            col.delegates = trs.delegates + delegates_delta;
+            col.committees = trs.committees;
+            col.open_ballots = trs.open_ballots + open_ballots_delta;
+        });
+    } else {
+        //apply deltas
+        trsstats.modify(ts_itr, same_payer, [&](auto& col) {
+            col.supply.amount += supply_delta;
+            col.voters += voters_delta;
+            col.delegates += delegates_delta;
+            col.open_ballots += open_ballots_delta;
+        });
+    }
+
+}
@@ -78,25 +78,85 @@ ACTION decide::regvoter(name voter, symbol treasury_symbol, optional<name> refer
     }
 
     //emplace new voter
-    voters.emplace(ram_payer, [&](auto& col) {
-        col.liquid = asset(0, treasury_symbol);
-        col.staked = asset(0, treasury_symbol);
-        col.staked_time = time_point_sec(current_time_point());
-        col.delegated = asset(0, treasury_symbol);
-        col.delegated_to = name(0);
-        col.delegation_time = time_point_sec(current_time_point());
-    });
+    add_voter(voters, voter, treasury_symbol, ram_payer);
 
-    //update treasury
-    treasuries.modify(trs, same_payer, [&](auto& col) {
-        col.voters += 1;
-    });
+    //update treasury voters
+    update_trs_stats(trs, 0, 1, 0, 0);
 
     if(treasury_symbol == VOTE_SYM) {
         sync_external_account(voter, VOTE_SYM, TLOS_SYM);
     }
 }
 
+ACTION decide::regvoters(vector<name> voter_names, symbol treasury_symbol, optional<name> referrer) {
+    
+    //open treasuries table, get treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(treasury_symbol.code().raw(), "treasury not found");
+
+    //validate
+    check(voter_names.size() > 0, "must register at least one voter");
+    check(treasury_symbol != TLOS_SYM, "cannot register as TLOS voter, use VOTE instead");
+
+    //initialize
+    name ram_payer = trs.manager;
+
+    //authenticate once for all voters
+    switch (trs.access.value) {
+        case (name("public").value):
+            check(referrer.has_value(), "referrer required to register voters on public treasury");
+            require_auth(*referrer);
+            ram_payer = *referrer;
+            break;
+        case (name("private").value):
+            if (referrer) {
+                check(*referrer == trs.manager, "referrer must be treasury manager");
+            }
+            require_auth(trs.manager);
+            break;
+        case (name("invite").value):
+            if (referrer) {
+
+                //initialize
+                name ref_name = *referrer;
+
+                //authenticate
+                require_auth(ref_name);
+
+                //check referrer is a registered voter of treasury
+                voters_table referrers(get_self(), ref_name.value);
+                referrers.get(treasury_symbol.code().raw(), "referrer not found");
+
+                //set referrer as ram payer
+                ram_payer = ref_name;
+            } else {
+                require_auth(trs.manager);
+            }
+            break;
+        default:
+            check(false, "access method doesn't support registering multiple voters");
+    }
+
+    //update treasury voters once, before external syncs update treasury supply
+    update_trs_stats(trs, 0, int32_t(voter_names.size()), 0, 0);
+
+    for (name v : voter_names) {
+        //open voters table, search for voter
+        voters_table voters(get_self(), v.value);
+
+        //validate
+        check(is_account(v), "voter account doesn't exist");
+        check(voters.find(treasury_symbol.code().raw()) == voters.end(), "voter already exists");
+
+        //emplace new voter
+        add_voter(voters, v, treasury_symbol, ram_payer);
+
+        if(treasury_symbol == VOTE_SYM) {
+            sync_external_account(v, VOTE_SYM, TLOS_SYM);
+        }
+    }
+}
+
 ACTION decide::unregvoter(name voter, symbol treasury_symbol) {
     
     //authenticate
@@ -113,14 +173,26 @@ ACTION decide::unregvoter(name voter, symbol treasury_symbol) {
     //validate
     check(vtr.liquid == asset(0, treasury_symbol), "cannot unregister unless liquid is zero");
     check(vtr.staked == asset(0, treasury_symbol), "cannot unregister unless staked is zero");
+    check(vtr.delegated_to == name(0), "cannot unregister while delegated");
 
     //TODO: let voter unregister anyway by sending liquid and staked amount to manager?
 
     //TODO: require voter to cleanup/unvote all existing vote receipts first?
 
-    treasuries.modify(trs, same_payer, [&](auto& col) {
-        col.voters -= 1;
-    });
+    //open delegates table, search for delegate
+    delegates_table delegates(get_self(), treasury_symbol.code().raw());
+    auto del_itr = delegates.find(voter.value);
+    int32_t delegates_delta = 0;
+
+    //unregister voter as delegate if registered
+    if (del_itr != delegates.end()) {
+        check(del_itr->constituents == 0, "delegate still has constituents");
+        delegates.erase(del_itr);
+        delegates_delta = -1;
+    }
+
+    //update treasury voters and delegates
+    update_trs_stats(trs, 0, -1, delegates_delta, 0);
 
     //erase account
     voters.erase(vtr);
@@ -136,101 +208,97 @@ ACTION decide::castvote(name voter, name ballot_name, vector<name> options) {
     ballots_table ballots(get_self(), get_self().value);
     auto& bal = ballots.get(ballot_name.value, "ballot not found");
 
-    //open voters table, get voter
-    voters_table voters(get_self(), voter.value);
-    auto& vtr = voters.get(bal.treasury_symbol.code().raw(), "voter not found");
+    //apply vote to ballot
+    apply_vote(ballots, bal, voter, options, get_vote_weight(voter, bal), voter);
 
-    //initialize
-    auto now = time_point_sec(current_time_point());
-    asset raw_vote_weight = asset(0, bal.treasury_symbol);
-    uint32_t new_voter = 1;
-    map<name, asset> temp_bal_options = bal.options;
+}
 
-    if (bal.settings.at(name("votestake"))) { //use stake
-        raw_vote_weight = vtr.staked;
-    } else { //use liquid
-        raw_vote_weight = vtr.liquid;
-    }
+ACTION decide::castvoteidx(name voter, name ballot_name, vector<uint8_t> option_indexes) {
+    
+    //authenticate
+    require_auth(voter);
 
-    asset raw_delta = raw_vote_weight;
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //apply vote to ballot
+    apply_vote(ballots, bal, voter, get_options_by_index(bal, option_indexes), get_vote_weight(voter, bal), voter);
+
+}
+
+ACTION decide::castmerkle(name voter, name ballot_name, vector<name> options, asset weight, vector<checksum256> proof) {
+    
+    //authenticate
+    require_auth(voter);
+
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //open merkle roots table, get merkle root
+    merkleroots_table merkleroots(get_self(), get_self().value);
+    auto& mr = merkleroots.get(ballot_name.value, "merkle root not found");
 
     //validate
-    check(bal.status == name("voting"), "ballot status is must be in voting mode to cast vote");
-    check(now >= bal.begin_time && now <= bal.end_time, "vote must occur between ballot begin and end times");
-    check(options.size() >= bal.min_options, "cannot vote for fewer than min options");
-    check(options.size() <= bal.max_options, "cannot vote for more than max options");
-    check(raw_vote_weight.amount > 0, "must vote with a positive amount");
+    check(weight.symbol == bal.treasury_symbol, "weight symbol must match ballot treasury symbol");
+    check(verify_merkle_proof(mr.root, voter, weight, proof), "invalid merkle proof");
 
-    //skip vote tracking if light ballot
-    if (bal.settings.at(name("lightballot"))) {
-        return;
-    }
+    //apply vote to ballot
+    apply_vote(ballots, bal, voter, options, weight, voter);
 
-    //open votes table, search for existing vote
-    votes_table votes(get_self(), ballot_name.value);
-    auto v_itr = votes.find(voter.value);
+}
 
-    //rollback if vote already exists
-    if (v_itr != votes.end()) {
-        
-        //initialize
-        auto v = *v_itr;
-        raw_delta -= v.raw_votes;
+ACTION decide::castsigned(name relayer, vector<signed_vote> votes) {
+    
+    //authenticate
+    require_auth(relayer);
 
-        //validate
-        check(bal.settings.at(name("revotable")), "ballot is not revotable");
+    //open sign domain singleton, get chain id
+    signdomain_singleton signdomain(get_self(), get_self().value);
+    check(signdomain.exists(), "chain id not set");
+    auto chain_id = signdomain.get().chain_id;
 
-        //rollback if weighted votes are not empty
-        if (!v.weighted_votes.empty()) {
-            
-            //rollback old votes
-            for (auto i = v.weighted_votes.begin(); i != v.weighted_votes.end(); i++) {
-                temp_bal_options[i->first] -= i->second;
-            }
+    //validate
+    check(votes.size() > 0, "must submit at least one signed vote");
 
-            //update new voter
-            new_voter = 0;
-        }
-    }
+    //open tables
+    ballots_table ballots(get_self(), get_self().value);
+    nonces_table nonces(get_self(), get_self().value);
 
-    //calculate new votes
-    auto new_votes = calc_vote_weights(bal.treasury_symbol, bal.voting_method, options, raw_vote_weight);
+    for (const auto& sv : votes) {
 
-    //apply new votes
-    for (auto i = new_votes.begin(); i != new_votes.end(); i++) {
-        
-        //validate
-        check(temp_bal_options.find(i->first) != temp_bal_options.end(), "option doesn't exist on ballot");
+        //get ballot
+        auto& bal = ballots.get(sv.ballot_name.value, "ballot not found");
 
-        //apply effective vote to ballot option
-        temp_bal_options[i->first] += i->second;
-    }
+        //search for voter nonce
+        auto n_itr = nonces.find(sv.voter.value);
 
-    //update ballot
-    ballots.modify(bal, same_payer, [&](auto& col) {
-        col.options = temp_bal_options;
-        col.total_voters += new_voter;
-        col.total_raw_weight += raw_delta;
-    });
+        //validate nonce
+        if (n_itr != nonces.end()) {
+            check(sv.nonce > n_itr->last_nonce, "nonce already used");
+        }
+
+        //validate signature and signing key
+        assert_recover_key(get_vote_digest(chain_id, sv), sv.sig, sv.signing_key);
+        check(check_permission_authorization(sv.voter, active_permission, { sv.signing_key }), 
+            "signing key does not satisfy voter's active permission");
+
+        //update nonce, relayer pays for new nonces
+        if (n_itr == nonces.end()) {
+            nonces.emplace(relayer, [&](auto& col) {
+                col.voter = sv.voter;
+                col.last_nonce = sv.nonce;
+            });
+        } else {
+            nonces.modify(n_itr, same_payer, [&](auto& col) {
+                col.last_nonce = sv.nonce;
+            });
+        }
+
+        //apply vote to ballot, relayer pays for new votes
+        apply_vote(ballots, bal, sv.voter, sv.options, get_vote_weight(sv.voter, bal), relayer);
 
-    //update existing votes, or emplace votes if new
-    if (new_voter == 1) {
-        votes.emplace(voter, [&](auto& col) {
-            col.voter = voter;
-            col.is_delegate = false;
-            col.raw_votes = raw_vote_weight;
-            col.weighted_votes = new_votes;
-            col.vote_time = time_point_sec(current_time_point());
-            col.worker = name(0);
-            col.rebalances = uint8_t(0);
-            col.rebalance_volume = asset(0, bal.treasury_symbol);
-        });
-    } else {
-        //update votes
-        votes.modify(v_itr, same_payer, [&](auto& col) {
-            col.raw_votes = raw_vote_weight;
-            col.weighted_votes = new_votes;
-        });
     }
 
 }
@@ -244,13 +312,10 @@ ACTION decide::unvoteall(name voter, name ballot_name) {
     ballots_table ballots(get_self(), get_self().value);
     auto& bal = ballots.get(ballot_name.value, "ballot not found");
 
-    //open voters table, get voter
-    voters_table voters(get_self(), voter.value);
-    auto& vtr = voters.get(bal.treasury_symbol.code().raw(), "voter not found");
-
-    //open votes table, get vote
-    votes_table votes(get_self(), ballot_name.value);
-    auto& v = votes.get(voter.value, "vote not found");
+    //open receipts table, get receipt
+    receipts_table receipts(get_self(), ballot_name.value);
+    migrate_vote(receipts, bal, voter, voter);
+    auto& rcpt = receipts.get(voter.value, "vote not found");
 
     //initialize
     map<name, asset> temp_bal_options = bal.options;
@@ -259,7 +324,7 @@ ACTION decide::unvoteall(name voter, name ballot_name) {
     //validate
     check(bal.status == name("voting"), "ballot must be in voting mode to unvote");
     check(now >= bal.begin_time && now <= bal.end_time, "must unvote between begin and end time");
-    check(!v.weighted_votes.empty(), "votes are already empty");
+    check(!rcpt.selections.empty(), "votes are already empty");
 
     //return if light ballot
     if (bal.settings.at(name("lightballot"))) {
@@ -267,7 +332,8 @@ ACTION decide::unvoteall(name voter, name ballot_name) {
     }
 
     //rollback old votes
-    for (auto i = v.weighted_votes.begin(); i != v.weighted_votes.end(); i++) {
+    auto old_votes = get_receipt_weights(bal, rcpt);
+    for (auto i = old_votes.begin(); i != old_votes.end(); i++) {
         temp_bal_options[i->first] -= i->second;
     }
 
@@ -275,13 +341,14 @@ ACTION decide::unvoteall(name voter, name ballot_name) {
     ballots.modify(bal, same_payer, [&](auto& col) {
         col.options = temp_bal_options;
         col.total_voters -= 1;
-        col.total_raw_weight -= v.raw_votes;
+        col.total_delegates -= rcpt.is_delegate ? 1 : 0;
+        col.total_raw_weight.amount -= rcpt.raw_votes;
     });
 
-    //clear all votes in map (preserves rebalance count)
-    votes.modify(v, same_payer, [&](auto& col) {
-        col.raw_votes = asset(0, bal.treasury_symbol);
-        col.weighted_votes.clear();
+    //clear all selections (preserves rebalance count)
+    receipts.modify(rcpt, same_payer, [&](auto& col) {
+        col.raw_votes = 0;
+        col.selections.clear();
     });
     
 }
@@ -339,8 +406,397 @@ ACTION decide::refresh(name voter) {
 
 }
 
+ACTION decide::regdelegate(name delegate_name, symbol treasury_symbol) {
+
+    //authenticate
+    require_auth(delegate_name);
+
+    //open voters table, get voter
+    voters_table voters(get_self(), delegate_name.value);
+    auto& vtr = voters.get(treasury_symbol.code().raw(), "voter not found");
+
+    //open treasuries table, get treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(treasury_symbol.code().raw(), "treasury not found");
+
+    //open delegates table, search for delegate
+    delegates_table delegates(get_self(), treasury_symbol.code().raw());
+    auto del_itr = delegates.find(delegate_name.value);
+
+    //validate
+    check(del_itr == delegates.end(), "delegate already exists");
+    check(vtr.delegated_to == name(0), "delegated voters cannot register as delegates");
+
+    //emplace new delegate
+    delegates.emplace(delegate_name, [&](auto& col) {
+        col.delegate_name = delegate_name;
+        col.total_delegated = asset(0, treasury_symbol);
+        col.constituents = 0;
+    });
+
+    //update delegate count
+    update_trs_stats(trs, 0, 0, 1, 0);
+
+}
+
+ACTION decide::unregdelegate(name delegate_name, symbol treasury_symbol) {
+
+    //authenticate
+    require_auth(delegate_name);
+
+    //open delegates table, get delegate
+    delegates_table delegates(get_self(), treasury_symbol.code().raw());
+    auto& del = delegates.get(delegate_name.value, "delegate not found");
+
+    //open treasuries table, get treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(treasury_symbol.code().raw(), "treasury not found");
+
+    //validate
+    check(del.constituents == 0, "delegate still has constituents");
+
+    //update delegate count
+    update_trs_stats(trs, 0, 0, -1, 0);
+
+    //erase delegate
+    delegates.erase(del);
+
+}
+
+ACTION decide::delegate(name voter, name delegate_name, symbol treasury_symbol, vector<name> ballot_names) {
+
+    //authenticate
+    require_auth(voter);
+
+    //open voters table, get voter
+    voters_table voters(get_self(), voter.value);
+    auto& vtr = voters.get(treasury_symbol.code().raw(), "voter not found");
+
+    //open delegates table, get delegate
+    delegates_table delegates(get_self(), treasury_symbol.code().raw());
+    auto& del = delegates.get(delegate_name.value, "delegate not found");
+
+    //validate
+    check(voter != delegate_name, "cannot delegate to self");
+    check(vtr.delegated_to == name(0), "voter already delegated, undelegate first");
+    check(delegates.find(voter.value) == delegates.end(), "delegates cannot delegate");
+
+    //add staked balance to delegate
+    delegates.modify(del, same_payer, [&](auto& col) {
+        col.total_delegated += vtr.staked;
+        col.constituents += 1;
+    });
+
+    //update voter
+    voters.modify(vtr, same_payer, [&](auto& col) {
+        col.delegated = vtr.staked;
+        col.delegated_to = delegate_name;
+        col.delegation_time = time_point_sec(current_time_point());
+    });
+
+    //move delegated stake on open delegate ballots
+    for (name ballot_name : ballot_names) {
+        sync_delegation(ballot_name, voter, delegate_name, treasury_symbol);
+    }
+
+}
+
+ACTION decide::undelegate(name voter, symbol treasury_symbol, vector<name> ballot_names) {
+
+    //authenticate
+    require_auth(voter);
+
+    //open voters table, get voter
+    voters_table voters(get_self(), voter.value);
+    auto& vtr = voters.get(treasury_symbol.code().raw(), "voter not found");
+
+    //validate
+    check(vtr.delegated_to != name(0), "voter is not delegated");
+
+    //initialize
+    name delegate_name = vtr.delegated_to;
+
+    //open delegates table, get delegate
+    delegates_table delegates(get_self(), treasury_symbol.code().raw());
+    auto& del = delegates.get(delegate_name.value, "delegate not found");
+
+    //subtract delegated balance from delegate
+    delegates.modify(del, same_payer, [&](auto& col) {
+        col.total_delegated -= vtr.delegated;
+        col.constituents -= 1;
+    });
+
+    //update voter
+    voters.modify(vtr, same_payer, [&](auto& col) {
+        col.delegated = asset(0, treasury_symbol);
+        col.delegated_to = name(0);
+        col.delegation_time = time_point_sec(current_time_point());
+    });
+
+    //return delegated stake on open delegate ballots
+    for (name ballot_name : ballot_names) {
+        sync_delegation(ballot_name, voter, delegate_name, treasury_symbol);
+    }
+
+}
+
 //======================== helper functions ========================
 
+void decide::add_voter(voters_table& voters, name voter, symbol treasury_symbol, name ram_payer) {
+
+    //emplace new voter
+    voters.emplace(ram_payer, [&](auto& col) {
+        col.liquid = asset(0, treasury_symbol);
+        col.staked = asset(0, treasury_symbol);
+        col.staked_time = time_point_sec(current_time_point());
+        col.delegated = asset(0, treasury_symbol);
+        col.delegated_to = name(0);
+        col.delegation_time = time_point_sec(current_time_point());
+    });
+
+}
+
+asset decide::get_vote_weight(name voter, const ballot& bal) {
+
+    //open voters table, get voter
+    voters_table voters(get_self(), voter.value);
+    auto& vtr = voters.get(bal.treasury_symbol.code().raw(), "voter not found");
+
+    //initialize
+    asset raw_vote_weight = asset(0, bal.treasury_symbol);
+
+    //validate
+    check(!setting_enabled(bal.settings, name("merklevote")), "votes on merkle ballot must be cast with castmerkle");
+
+    if (bal.settings.at(name("votestake"))) { //use stake
+        raw_vote_weight = vtr.staked;
+    } else { //use liquid
+        raw_vote_weight = vtr.liquid;
+    }
+
+    //use balance as of ballot begin time if snapshot ballot
+    if (setting_enabled(bal.settings, name("votesnapshot"))) {
+        raw_vote_weight = get_snapshot_weight(voter, raw_vote_weight, bal.begin_time, bal.settings.at(name("votestake")));
+    }
+
+    //delegates vote with their constituents' delegated stake
+    if (setting_enabled(bal.settings, name("allowdgate"))) {
+        check(vtr.delegated_to == name(0), "delegated voters cannot vote on delegate ballots");
+        raw_vote_weight += get_delegated_weight(voter, bal.treasury_symbol);
+    }
+
+    return raw_vote_weight;
+}
+
+vector<name> decide::get_options_by_index(const ballot& bal, const vector<uint8_t>& option_indexes) {
+
+    //validate
+    check(option_indexes.size() <= bal.options.size(), "cannot vote for more options than ballot has");
+
+    //index options in name order, fixed once voting opens
+    vector<name> option_names;
+    option_names.reserve(bal.options.size());
+    for (auto i = bal.options.begin(); i != bal.options.end(); i++) {
+        option_names.push_back(i->first);
+    }
+
+    //initialize
+    vector<name> selections;
+    vector<bool> selected(option_names.size(), false);
+
+    //keep index order for ranked ballots
+    for (uint8_t idx : option_indexes) {
+        
+        //validate
+        check(idx < option_names.size(), "option index out of range");
+        check(!selected[idx], "option index selected more than once");
+
+        selected[idx] = true;
+        selections.push_back(option_names[idx]);
+    }
+
+    return selections;
+}
+
+vector<uint8_t> decide::get_option_indexes(const ballot& bal, const vector<name>& options) {
+
+    //index options in name order, fixed once voting opens
+    vector<name> option_names;
+    option_names.reserve(bal.options.size());
+    for (auto i = bal.options.begin(); i != bal.options.end(); i++) {
+        option_names.push_back(i->first);
+    }
+
+    //validate
+    check(option_names.size() <= max_ballot_options, "ballot cannot have more than 256 options");
+
+    //initialize
+    vector<uint8_t> option_indexes;
+    vector<bool> selected(option_names.size(), false);
+
+    //keep option order for ranked ballots
+    for (name n : options) {
+        auto itr = lower_bound(option_names.begin(), option_names.end(), n);
+
+        //validate
+        check(itr != option_names.end() && *itr == n, "option doesn't exist on ballot");
+
+        uint8_t idx = uint8_t(itr - option_names.begin());
+
+        //validate
+        check(!selected[idx], "option selected more than once");
+
+        selected[idx] = true;
+        option_indexes.push_back(idx);
+    }
+
+    return option_indexes;
+}
+
+map<name, asset> decide::get_receipt_weights(const ballot& bal, const receipt& rcpt) {
+
+    //return empty map if receipt has been unvoted
+    if (rcpt.selections.empty()) {
+        return map<name, asset>();
+    }
+
+    return calc_vote_weights(bal.treasury_symbol, bal.voting_method, get_options_by_index(bal, rcpt.selections), 
+        asset(rcpt.raw_votes, bal.treasury_symbol));
+}
+
+void decide::migrate_vote(receipts_table& receipts, const ballot& bal, name voter, name ram_payer) {
+
+    //open votes table, search for legacy vote
+    votes_table votes(get_self(), bal.ballot_name.value);
+    auto v_itr = votes.find(voter.value);
+
+    //return if no legacy vote
+    if (v_itr == votes.end()) {
+        return;
+    }
+
+    //rebuild selections from weighted votes
+    //NOTE: ranked voting isn't enabled, so name order is the vote order
+    vector<name> selections;
+    for (auto i = v_itr->weighted_votes.begin(); i != v_itr->weighted_votes.end(); i++) {
+        selections.push_back(i->first);
+    }
+
+    //emplace receipt
+    receipts.emplace(ram_payer, [&](auto& col) {
+        col.voter = v_itr->voter;
+        col.is_delegate = v_itr->is_delegate;
+        col.raw_votes = v_itr->raw_votes.amount;
+        col.selections = get_option_indexes(bal, selections);
+        col.vote_time = v_itr->vote_time;
+        col.worker = v_itr->worker;
+        col.rebalances = v_itr->rebalances;
+        col.rebalance_volume = v_itr->rebalance_volume.amount;
+    });
+
+    //erase legacy vote
+    votes.erase(v_itr);
+
+}
+
+void decide::apply_vote(ballots_table& ballots, const ballot& bal, name voter, vector<name> options, 
+    asset raw_vote_weight, name ram_payer) {
+
+    //initialize
+    auto now = time_point_sec(current_time_point());
+    uint32_t new_voter = 1;
+    map<name, asset> temp_bal_options = bal.options;
+    asset raw_delta = raw_vote_weight;
+
+    //validate
+    check(bal.status == name("voting"), "ballot status is must be in voting mode to cast vote");
+    check(now >= bal.begin_time && now <= bal.end_time, "vote must occur between ballot begin and end times");
+    check(options.size() >= bal.min_options, "cannot vote for fewer than min options");
+    check(options.size() <= bal.max_options, "cannot vote for more than max options");
+    check(raw_vote_weight.amount > 0, "must vote with a positive amount");
+
+    //skip vote tracking if light ballot
+    if (bal.settings.at(name("lightballot"))) {
+        return;
+    }
+
+    //validate options and get option indexes
+    auto selections = get_option_indexes(bal, options);
+
+    //check if vote is cast by a delegate
+    delegates_table delegates(get_self(), bal.treasury_symbol.code().raw());
+    bool is_delegate = setting_enabled(bal.settings, name("allowdgate")) && 
+        delegates.find(voter.value) != delegates.end();
+    int32_t delegate_delta = is_delegate ? 1 : 0;
+
+    //open receipts table, search for existing receipt
+    receipts_table receipts(get_self(), bal.ballot_name.value);
+    migrate_vote(receipts, bal, voter, ram_payer);
+    auto r_itr = receipts.find(voter.value);
+
+    //rollback if receipt already exists
+    if (r_itr != receipts.end()) {
+        
+        //initialize
+        raw_delta.amount -= r_itr->raw_votes;
+
+        //validate
+        check(bal.settings.at(name("revotable")), "ballot is not revotable");
+
+        //rollback if selections are not empty
+        if (!r_itr->selections.empty()) {
+            
+            //rollback old votes
+            auto old_votes = get_receipt_weights(bal, *r_itr);
+            for (auto i = old_votes.begin(); i != old_votes.end(); i++) {
+                temp_bal_options[i->first] -= i->second;
+            }
+
+            //update new voter
+            new_voter = 0;
+            delegate_delta -= r_itr->is_delegate ? 1 : 0;
+        }
+    }
+
+    //calculate new votes
+    auto new_votes = calc_vote_weights(bal.treasury_symbol, bal.voting_method, options, raw_vote_weight);
+
+    //apply new votes
+    for (auto i = new_votes.begin(); i != new_votes.end(); i++) {
+        temp_bal_options[i->first] += i->second;
+    }
+
+    //update ballot
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.options = temp_bal_options;
+        col.total_voters += new_voter;
+        col.total_delegates += delegate_delta;
+        col.total_raw_weight += raw_delta;
+    });
+
+    //update existing receipt, or emplace receipt if new
+    if (r_itr == receipts.end()) {
+        receipts.emplace(ram_payer, [&](auto& col) {
+            col.voter = voter;
+            col.is_delegate = is_delegate;
+            col.raw_votes = raw_vote_weight.amount;
+            col.selections = selections;
+            col.vote_time = now;
+            col.worker = name(0);
+            col.rebalances = uint8_t(0);
+            col.rebalance_volume = 0;
+        });
+    } else {
+        //update receipt, moving it to account that authorized vote
+        receipts.modify(r_itr, ram_payer, [&](auto& col) {
+            col.is_delegate = is_delegate;
+            col.raw_votes = raw_vote_weight.amount;
+            col.selections = selections;
+        });
+    }
+
+}
+
 map<name, asset> decide::calc_vote_weights(symbol treasury_symbol, name voting_method, 
     vector<name> selections,  asset raw_vote_weight) {
     
@@ -386,4 +842,107 @@ map<name, asset> decide::calc_vote_weights(symbol treasury_symbol, name voting_m
     }
 
     return vote_weights;
-}
\ No newline at end of file
+}
+void decide::rebalance_vote(ballots_table& ballots, const ballot& bal, receipts_table& receipts, const receipt& rcpt, 
+    optional<name> worker) {
+
+    //open voters table, get voter
+    voters_table voters(get_self(), rcpt.voter.value);
+    auto& vtr = voters.get(bal.treasury_symbol.code().raw(), "voter not found");
+
+    //initialize
+    asset raw_vote_weight = asset(0, bal.treasury_symbol);
+    map<name, asset> new_bal_options = bal.options;
+    name worker_name = name(0);
+
+    if (bal.settings.at(name("votestake"))) { //use stake
+        raw_vote_weight = vtr.staked;
+    } else { //use liquid
+        raw_vote_weight = vtr.liquid;
+    }
+
+    //delegated stake is counted on the delegate's receipt
+    if (setting_enabled(bal.settings, name("allowdgate"))) {
+        if (rcpt.is_delegate) {
+            raw_vote_weight += get_delegated_weight(rcpt.voter, bal.treasury_symbol);
+        } else if (vtr.delegated_to != name(0)) {
+            raw_vote_weight.amount = 0;
+        }
+    }
+
+    //check(raw_vote_weight.amount != rcpt.raw_votes, "vote is already balanced");
+
+    //if vote is not balanced
+    if (raw_vote_weight.amount != rcpt.raw_votes) {
+
+        //validate
+        check(rcpt.selections.size() > 0, "cannot rebalance nonexistent votes");
+
+        //rollback old vote
+        auto old_votes = get_receipt_weights(bal, rcpt);
+        for (auto i = old_votes.begin(); i != old_votes.end(); i++) {
+            new_bal_options[i->first] -= i->second;
+        }
+
+        //calculate new votes
+        auto new_votes = calc_vote_weights(bal.treasury_symbol, bal.voting_method, 
+            get_options_by_index(bal, rcpt.selections), raw_vote_weight);
+        int64_t weight_delta = abs(rcpt.raw_votes - raw_vote_weight.amount);
+
+        //apply new votes to ballot
+        for (auto i = new_votes.begin(); i != new_votes.end(); i++) {
+            new_bal_options[i->first] += i->second;
+        }
+
+        //update ballot
+        ballots.modify(bal, same_payer, [&](auto& col) {
+            col.options = new_bal_options;
+            col.total_raw_weight.amount += (raw_vote_weight.amount - rcpt.raw_votes);
+        });
+
+        //set worker info if applicable
+        if (worker) {
+            //authenticate
+            require_auth(*worker);
+            worker_name = *worker;
+        }
+
+        //update receipt
+        receipts.modify(rcpt, same_payer, [&](auto& col) {
+            col.raw_votes = raw_vote_weight.amount;
+            col.worker = worker_name;
+            col.rebalances += 1;
+            col.rebalance_volume = weight_delta;
+        });
+
+    }
+
+}
+
+void decide::sync_delegation(name ballot_name, name voter, name delegate_name, symbol treasury_symbol) {
+
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //initialize
+    auto now = time_point_sec(current_time_point());
+
+    //validate
+    check(bal.treasury_symbol == treasury_symbol, "ballot treasury symbol mismatch");
+    check(setting_enabled(bal.settings, name("allowdgate")), "ballot does not allow delegates");
+    check(bal.status == name("voting") && now < bal.end_time, "ballot must be open for voting");
+
+    //open receipts table
+    //NOTE: delegate ballots postdate legacy votes, so there is nothing to migrate
+    receipts_table receipts(get_self(), ballot_name.value);
+
+    //move delegated stake between voter's and delegate's receipts
+    for (name account : { voter, delegate_name }) {
+        auto r_itr = receipts.find(account.value);
+        if (r_itr != receipts.end() && !r_itr->selections.empty()) {
+            rebalance_vote(ballots, bal, receipts, *r_itr, {});
+        }
+    }
+
+}
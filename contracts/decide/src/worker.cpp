@@ -9,29 +9,11 @@ ACTION decide::forfeitwork(name worker_name, symbol treasury_symbol) {
     labors_table labors(get_self(), treasury_symbol.code().raw());
     auto& lab = labors.get(worker_name.value, "labor not found");
 
-    //open labor buckets table, get workers bucket
-    laborbuckets_table laborbuckets(get_self(), treasury_symbol.code().raw());
-    auto& bucket = laborbuckets.get(name("workers").value, "workers bucket not found");
-
     //authenticate
     require_auth(lab.worker_name);
 
-    //initialize
-    auto new_claimable_volume = bucket.claimable_volume;
-    auto new_claimable_events = bucket.claimable_events;
-
-    new_claimable_volume[name("rebalvolume")] -= lab.unclaimed_volume.at(name("rebalvolume"));
-    new_claimable_events[name("rebalcount")] -= lab.unclaimed_events.at(name("rebalcount"));
-    new_claimable_events[name("cleancount")] -= lab.unclaimed_events.at(name("cleancount"));
-
-    //update labor bucket
-    laborbuckets.modify(bucket, same_payer, [&](auto& col) {
-        col.claimable_volume = new_claimable_volume;
-        col.claimable_events = new_claimable_events;
-    });
-
-    //erase worker
-    labors.erase(lab);
+    //forfeit labor
+    forfeit_labor(labors, lab);
 }
 
 ACTION decide::claimpayment(name claimant, symbol treasury_symbol) {
@@ -162,90 +144,36 @@ ACTION decide::rebalance(name voter, name ballot_name, optional<name> worker) {
     ballots_table ballots(get_self(), get_self().value);
     auto& bal = ballots.get(ballot_name.value, "ballot not found");
 
-    //open voters table, get voter
-    voters_table voters(get_self(), voter.value);
-    auto& vtr = voters.get(bal.treasury_symbol.code().raw(), "voter not found");
-
-    //open votes table, get vote
-    votes_table votes(get_self(), ballot_name.value);
-    auto& v = votes.get(voter.value, "vote not found");
+    //open receipts table, get receipt
+    //NOTE: voter pays for migrated receipt, which is smaller than the legacy vote it replaces
+    receipts_table receipts(get_self(), ballot_name.value);
+    migrate_vote(receipts, bal, voter, voter);
+    auto& rcpt = receipts.get(voter.value, "vote not found");
 
     //initialize
     auto now = time_point_sec(current_time_point());
-    asset raw_vote_weight = asset(0, bal.treasury_symbol);
-    map<name, asset> new_bal_options = bal.options;
-    vector<name> selections;
-    name worker_name = name(0);
 
     //validate
     check(now < bal.end_time, "vote has already expired");
+    check(!setting_enabled(bal.settings, name("votesnapshot")), "snapshot ballot votes never need rebalancing");
+    check(!setting_enabled(bal.settings, name("merklevote")), "merkle ballot votes never need rebalancing");
 
-    if (bal.settings.at(name("votestake"))) { //use stake
-        raw_vote_weight = vtr.staked;
-    } else { //use liquid
-        raw_vote_weight = vtr.liquid;
-    }
-
-    //check(raw_vote_weight != v.raw_votes, "vote is already balanced");
-
-    //if vote is not balanced
-    if (raw_vote_weight != v.raw_votes) {
-
-        //rollback old vote
-        for (auto i = v.weighted_votes.begin(); i != v.weighted_votes.end(); i++) {
-            new_bal_options[i->first] -= i->second;
-
-            //rebuild selections
-            selections.push_back(i->first);
-        }
-
-        //validate
-        check(selections.size() > 0, "cannot rebalance nonexistent votes");
-
-        //calculate new votes
-        auto new_votes = calc_vote_weights(bal.treasury_symbol, bal.voting_method, selections, raw_vote_weight);
-        int64_t weight_delta = abs(v.raw_votes.amount - raw_vote_weight.amount);
-
-        //apply new votes to ballot
-        for (auto i = new_votes.begin(); i != new_votes.end(); i++) {
-            new_bal_options[i->first] += i->second;
-        }
-
-        //update ballot
-        ballots.modify(bal, same_payer, [&](auto& col) {
-            col.options = new_bal_options;
-            col.total_raw_weight += (raw_vote_weight - v.raw_votes);
-        });
-
-        //set worker info if applicable
-        if (worker) {
-            //authenticate
-            require_auth(*worker);
-            worker_name = *worker;
-        }
-
-        //update vote
-        votes.modify(v, same_payer, [&](auto& col) {
-            col.raw_votes = raw_vote_weight;
-            col.weighted_votes = new_votes;
-            col.worker = worker_name;
-            col.rebalances += 1;
-            col.rebalance_volume = asset(weight_delta, bal.treasury_symbol);
-        });
-
-    }
+    //apply voter's current weight to ballot
+    rebalance_vote(ballots, bal, receipts, rcpt, worker);
 
 }
 
 ACTION decide::cleanupvote(name voter, name ballot_name, optional<name> worker) {
-    //open votes table, get vote
-    votes_table votes(get_self(), ballot_name.value);
-    auto& v = votes.get(voter.value, "vote not found");
-
     //open ballots table, get ballot
     ballots_table ballots(get_self(), get_self().value);
     auto& bal = ballots.get(ballot_name.value, "ballot not found");
 
+    //open receipts table, get receipt
+    //NOTE: migrated receipt is erased below, so contract pays nothing
+    receipts_table receipts(get_self(), ballot_name.value);
+    migrate_vote(receipts, bal, voter, get_self());
+    auto& rcpt = receipts.get(voter.value, "vote not found");
+
     //open treasuries table, get treasury
     treasuries_table treasuries(get_self(), get_self().value);
     auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
@@ -267,14 +195,211 @@ ACTION decide::cleanupvote(name voter, name ballot_name, optional<name> worker)
         log_cleanup_work(*worker, bal.treasury_symbol, 1);
     }
 
-    //log rebalance work from vote
-    if (v.worker != name(0)) {
-        log_rebalance_work(v.worker, bal.treasury_symbol, v.rebalance_volume, 1);
+    //log rebalance work from receipt
+    if (rcpt.worker != name(0)) {
+        log_rebalance_work(rcpt.worker, bal.treasury_symbol, asset(rcpt.rebalance_volume, bal.treasury_symbol), 1);
+    }
+
+    //erase expired receipt
+    receipts.erase(rcpt);
+    
+}
+
+ACTION decide::migratevotes(name ballot_name, uint16_t count) {
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //open votes table
+    votes_table votes(get_self(), ballot_name.value);
+    auto v_itr = votes.begin();
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //validate
+    check(count > 0, "count must be greater than zero");
+    check(v_itr != votes.end(), "no legacy votes to migrate");
+
+    //open receipts table
+    receipts_table receipts(get_self(), ballot_name.value);
+
+    //migrate up to count votes, resumes from first remaining vote on next call
+    while (v_itr != votes.end() && count > 0) {
+        name voter = v_itr->voter;
+        v_itr++;
+        migrate_vote(receipts, bal, voter, bal.publisher);
+        count--;
     }
 
-    //erase expired vote
-    votes.erase(v);
+}
+
+ACTION decide::indexballots(name payer, uint16_t count) {
     
+    //open index cursor singleton, get cursor
+    idxcursor_singleton idxcursor(get_self(), get_self().value);
+    auto cursor = idxcursor.get_or_default(index_cursor{});
+
+    //open ballots table, resume after last indexed ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto bal_itr = ballots.upper_bound(cursor.last_indexed.value);
+
+    //open ballot index table
+    ballotidx_table ballotidx(get_self(), get_self().value);
+
+    //authenticate
+    require_auth(payer);
+
+    //validate
+    check(count > 0, "count must be greater than zero");
+    check(bal_itr != ballots.end(), "no ballots left to index");
+
+    //index ballots missing an index row
+    for (uint16_t i = 0; i < count && bal_itr != ballots.end(); i++, bal_itr++) {
+        if (ballotidx.find(bal_itr->ballot_name.value) == ballotidx.end()) {
+            add_ballot_index(*bal_itr, payer);
+        }
+        cursor.last_indexed = bal_itr->ballot_name;
+    }
+
+    //save cursor
+    idxcursor.set(cursor, get_self());
+
+}
+
+ACTION decide::tick(uint16_t max_work) {
+    //validate
+    check(max_work > 0, "max work must be greater than zero");
+
+    //open tick cursor singleton, get cursor
+    tickcursor_singleton tickcursor(get_self(), get_self().value);
+    auto cursor = tickcursor.get_or_default(tick_cursor{});
+
+    //initialize
+    auto now = time_point_sec(current_time_point()).sec_since_epoch();
+    uint32_t close_grace = get_config_time(name("closegrace"), uint32_t(86400));
+    uint32_t labor_expiry = 101 * 86400; //claimpayment diminishes payout 1% per day after the first day
+    uint16_t work = 0;
+
+    //open ballots table, get end time index
+    ballots_table ballots(get_self(), get_self().value);
+    auto by_end_time = ballots.get_index<name("byendtime")>();
+    auto b_itr = by_end_time.lower_bound(static_cast<uint64_t>(cursor.ballot_end_time.utc_seconds));
+
+    //close expired ballots in end time order
+    //NOTE: publishers have the close grace period to close (and broadcast) their own ballots
+    while (b_itr != by_end_time.end() && work < max_work) {
+
+        //skip ballots ticked on a previous call with the same end time
+        if (b_itr->end_time == cursor.ballot_end_time && b_itr->ballot_name.value <= cursor.ballot_name.value) {
+            b_itr++;
+            continue;
+        }
+
+        //stop at first ballot still in close grace period
+        if (b_itr->end_time.sec_since_epoch() + close_grace >= now) {
+            break;
+        }
+
+        //light ballots are closed by publisher after posting results
+        name ballot_name = b_itr->ballot_name;
+        bool closeable = b_itr->status == name("voting") && !b_itr->settings.at(name("lightballot"));
+        cursor.ballot_end_time = b_itr->end_time;
+        cursor.ballot_name = ballot_name;
+        b_itr++;
+        work++;
+
+        //NOTE: cranker isn't authorized as publisher, so contract pays for results of ballots left unclosed
+        if (closeable) {
+            close_ballot(ballots, ballots.get(ballot_name.value), false, get_self());
+        }
+    }
+
+    //open archivals table, resume from cursor
+    archivals_table archivals(get_self(), get_self().value);
+    auto a_itr = archivals.lower_bound(cursor.archival_name.value);
+
+    //unarchive expired archivals
+    while (a_itr != archivals.end() && work < max_work) {
+        if (a_itr->archived_until.sec_since_epoch() < now) {
+            release_archive(ballots, a_itr->ballot_name);
+            a_itr = archivals.erase(a_itr);
+        } else {
+            a_itr++;
+        }
+        work++;
+    }
+
+    //wrap to first archival when end is reached
+    cursor.archival_name = a_itr == archivals.end() ? name(0) : a_itr->ballot_name;
+
+    //open treasuries table, resume from cursor
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto t_itr = treasuries.lower_bound(cursor.labor_symbol.code().raw());
+
+    //forfeit labor with nothing left to pay in each treasury
+    //NOTE: labor past forfeit time is still owed, anyone can settle it to the worker with claimpayment
+    while (t_itr != treasuries.end() && work < max_work) {
+
+        //open labors table, resume from cursor if same treasury
+        labors_table labors(get_self(), t_itr->supply.symbol.code().raw());
+        auto l_itr = labors.lower_bound(t_itr->supply.symbol == cursor.labor_symbol ? cursor.labor_worker.value : 0);
+
+        while (l_itr != labors.end() && work < max_work) {
+            if (l_itr->start_time.sec_since_epoch() + labor_expiry <= now) {
+                const auto& lab = *l_itr;
+                l_itr++;
+                forfeit_labor(labors, lab);
+            } else {
+                l_itr++;
+            }
+            work++;
+        }
+
+        //save position if out of work
+        if (l_itr != labors.end()) {
+            cursor.labor_symbol = t_itr->supply.symbol;
+            cursor.labor_worker = l_itr->worker_name;
+            break;
+        }
+
+        //move to next treasury, wraps to first treasury when end is reached
+        t_itr++;
+        cursor.labor_symbol = t_itr == treasuries.end() ? symbol() : t_itr->supply.symbol;
+        cursor.labor_worker = name(0);
+    }
+
+    //save cursor
+    tickcursor.set(cursor, get_self());
+}
+
+void decide::forfeit_labor(labors_table& labors, const labor& lab) {
+    //open labor buckets table, search for workers bucket
+    laborbuckets_table laborbuckets(get_self(), labors.get_scope());
+    auto b_itr = laborbuckets.find(name("workers").value);
+
+    //remove unclaimed work from bucket
+    //NOTE: labor may not have every volume and event type, only subtract what exists
+    if (b_itr != laborbuckets.end()) {
+        laborbuckets.modify(b_itr, same_payer, [&](auto& col) {
+            for (auto i = lab.unclaimed_volume.begin(); i != lab.unclaimed_volume.end(); i++) {
+                auto v_itr = col.claimable_volume.find(i->first);
+                if (v_itr != col.claimable_volume.end()) {
+                    v_itr->second -= i->second;
+                }
+            }
+
+            for (auto i = lab.unclaimed_events.begin(); i != lab.unclaimed_events.end(); i++) {
+                auto e_itr = col.claimable_events.find(i->first);
+                if (e_itr != col.claimable_events.end()) {
+                    e_itr->second -= i->second;
+                }
+            }
+        });
+    }
+
+    //erase labor
+    labors.erase(lab);
 }
 
 void decide::log_rebalance_work(name worker, symbol treasury_symbol, asset volume, uint16_t count) {
@@ -6,6 +6,7 @@
 #include <eosio/eosio.hpp>
 #include <eosio/asset.hpp>
 #include <eosio/action.hpp>
+#include <eosio/singleton.hpp>
 
 using namespace std;
 using namespace eosio;
@@ -20,17 +21,44 @@ public:
 
     //======================== actions ========================
 
-    //start watching a ballot
+    //sets the decide contract to accept broadcasts from
+    ACTION setconfig(name decide_contract);
+
+    //start watching a ballot for a single committee seat
     ACTION watchballot(name ballot_name, symbol treasury_symbol, name committee_name, name seat_name);
 
+    //start watching a multi-winner ballot, winners are assigned to seats in rank order
+    //NOTE: requires contract authority, watches send assignseats and subscribe as the contract
+    ACTION watchseats(name ballot_name, symbol treasury_symbol, name committee_name, vector<name> seat_names);
+
+    //stop watching a ballot for a committee
+    ACTION unwatch(name ballot_name, symbol treasury_symbol, name committee_name);
+
     //======================== notification actions ========================
 
-    [[eosio::on_notify("telos.decide::broadcast")]]
+    //broadcasts from any contract other than the configured decide contract are ignored
+    [[eosio::on_notify("*::broadcast")]]
     void catch_broadcast(name ballot_name, map<name, asset> final_results, uint32_t total_voters);
 
+    //======================== functions ========================
+
+    //returns configured decide contract, telos.decide if not set
+    name get_decide_contract();
+
+    //returns committee key of a seat watch, committee names are only unique within a treasury
+    static uint128_t committee_key(name committee_name, symbol treasury_symbol);
+
     //======================== tables ========================
 
-    //watched ballots
+    //scope: self
+    TABLE config {
+        name decide_contract;
+
+        EOSLIB_SERIALIZE(config, (decide_contract))
+    };
+    typedef singleton<name("config"), config> config_singleton;
+
+    //NOTE: legacy watched ballots, new watches are written to seatwatches
     //scope: self
     TABLE open_ballot {
         name ballot_name;
@@ -43,4 +71,50 @@ public:
     };
     typedef multi_index<name("openballots"), open_ballot> openballots_table;
 
-};
\ No newline at end of file
+    //watched ballots, erased after results are handled
+    //scope: ballot_name.value
+    TABLE seat_watch {
+        uint64_t watch_id;
+        name ballot_name;
+        symbol treasury_symbol;
+        name committee_name;
+        vector<name> seat_names;
+
+        uint64_t primary_key() const { return watch_id; }
+        uint128_t by_committee() const { return committee_key(committee_name, treasury_symbol); }
+        EOSLIB_SERIALIZE(seat_watch, (watch_id)(ballot_name)(treasury_symbol)(committee_name)(seat_names))
+    };
+    typedef multi_index<name("seatwatches"), seat_watch,
+        indexed_by<name("bycommittee"), const_mem_fun<seat_watch, uint128_t, &seat_watch::by_committee>>
+    > seatwatches_table;
+
+    //======================== decide tables ========================
+
+    struct ranked_option {
+        name option_name;
+        asset votes;
+        uint16_t bps;
+
+        EOSLIB_SERIALIZE(ranked_option, (option_name)(votes)(bps))
+    };
+
+    //ballot results written by decide at close
+    //scope: decide_contract.value
+    struct result {
+        name ballot_name;
+        symbol treasury_symbol;
+        vector<ranked_option> ranked_options;
+        vector<name> winners;
+        asset total_raw_weight;
+        uint32_t total_voters;
+        uint16_t turnout_bps;
+        time_point_sec close_time;
+
+        uint64_t primary_key() const { return ballot_name.value; }
+        EOSLIB_SERIALIZE(result, 
+            (ballot_name)(treasury_symbol)(ranked_options)(winners)
+            (total_raw_weight)(total_voters)(turnout_bps)(close_time))
+    };
+    typedef multi_index<name("results"), result> results_table;
+
+};
@@ -6,59 +6,175 @@ watcher::~watcher() { }
 
 //======================== actions ========================
 
+ACTION watcher::setconfig(name decide_contract) {
+
+    //authenticate
+    require_auth(get_self());
+
+    //validate
+    check(is_account(decide_contract), "decide contract account doesn't exist");
+
+    //open config singleton, set config
+    config_singleton configs(get_self(), get_self().value);
+    configs.set(config{ decide_contract }, get_self());
+
+}
+
 ACTION watcher::watchballot(name ballot_name, symbol treasury_symbol, name committee_name, name seat_name) {
+
+    //watch ballot for a single seat
+    watchseats(ballot_name, treasury_symbol, committee_name, { seat_name });
+
+}
+
+ACTION watcher::watchseats(name ballot_name, symbol treasury_symbol, name committee_name, vector<name> seat_names) {
+
+    //authenticate
+    require_auth(get_self());
     
-    //open open_ballots table, search for open ballot
-    openballots_table openballots(get_self(), get_self().value);
-    auto ob = openballots.find(ballot_name.value);
+    //open seat watches table, search for seat watch by committee
+    seatwatches_table seatwatches(get_self(), ballot_name.value);
+    auto by_committee = seatwatches.get_index<name("bycommittee")>();
+    auto sw = by_committee.find(committee_key(committee_name, treasury_symbol));
 
     //validate
-    check(ob == openballots.end(), "ballot is already being watched");
+    check(sw == by_committee.end(), "committee is already watching ballot");
+    check(seat_names.size() > 0, "must watch at least one seat");
+
+    //subscribe to ballot broadcast on first watch
+    //requires get_self()@eosio.code to be under get_self()@active
+    if (seatwatches.begin() == seatwatches.end()) {
+        action(permission_level{get_self(), name("active")}, get_decide_contract(), name("subscribe"), make_tuple(
+            get_self(), //listener
+            ballot_name //ballot_name
+        )).send();
+    }
 
-    //emplace open ballot
-    openballots.emplace(get_self(), [&](auto& col) {
+    //emplace seat watch
+    seatwatches.emplace(get_self(), [&](auto& col) {
+        col.watch_id = seatwatches.available_primary_key();
         col.ballot_name = ballot_name;
         col.treasury_symbol = treasury_symbol;
         col.committee_name = committee_name;
-        col.seat_name = seat_name;
+        col.seat_names = seat_names;
     });
 
 }
 
+ACTION watcher::unwatch(name ballot_name, symbol treasury_symbol, name committee_name) {
+
+    //authenticate
+    require_auth(get_self());
+
+    //open seat watches table, get seat watch by committee
+    seatwatches_table seatwatches(get_self(), ballot_name.value);
+    auto by_committee = seatwatches.get_index<name("bycommittee")>();
+    auto& sw = by_committee.get(committee_key(committee_name, treasury_symbol), "committee is not watching ballot");
+
+    //erase seat watch
+    seatwatches.erase(sw);
+
+    //unsubscribe from ballot broadcast after last watch
+    if (seatwatches.begin() == seatwatches.end()) {
+        action(permission_level{get_self(), name("active")}, get_decide_contract(), name("unsubscribe"), make_tuple(
+            get_self(), //listener
+            ballot_name //ballot_name
+        )).send();
+    }
+
+}
+
 void watcher::catch_broadcast(name ballot_name, map<name, asset> final_results, uint32_t total_voters) {
-    
-    //get initial receiver contract
-    name rec = get_first_receiver();
-
-    if (rec == name("telos.decide")) {
-        
-        //open open_ballots table, search for open ballot
-        openballots_table openballots(get_self(), get_self().value);
-        auto ob = openballots.find(ballot_name.value);
-
-        if (ob != openballots.end()) {
-
-            symbol treasury_symbol;
-            name new_seat_holder;
-            asset most_votes = asset(0, treasury_symbol);
-
-            for (auto itr = final_results.begin(); itr != final_results.end(); itr++) {
-                if (final_results[itr->first] > most_votes) {
-                    new_seat_holder = itr->first;
-                    most_votes = itr->second;
-                    treasury_symbol = itr->second.symbol;
-                }
+
+    //initialize
+    name decide_contract = get_decide_contract();
+
+    //ignore broadcasts from other contracts
+    if (get_first_receiver() != decide_contract) {
+        return;
+    }
+
+    //open open_ballots table, search for legacy watch
+    openballots_table openballots(get_self(), get_self().value);
+    auto ob = openballots.find(ballot_name.value);
+
+    if (ob != openballots.end()) {
+
+        //find option with most votes in a single pass, ties go to lowest option name
+        name new_seat_holder;
+        int64_t most_votes = 0;
+        for (auto& fr : final_results) {
+            if (fr.second.amount > most_votes) {
+                new_seat_holder = fr.first;
+                most_votes = fr.second.amount;
             }
-            
+        }
+
+        if (new_seat_holder != name(0)) {
             //requires get_self()@eosio.code to be under get_self()@active
-            action(permission_level{get_self(), name("active")}, name("telos.decide"), name("assignseat"), make_tuple(
+            action(permission_level{get_self(), name("active")}, decide_contract, name("assignseat"), make_tuple(
                 ob->committee_name, //committee_name
                 ob->treasury_symbol, //treasury_symbol
                 ob->seat_name, //seat_name
                 new_seat_holder, //seat_holder
                 std::string("auto-assigned from ballot results") //memo
             )).send();
+        }
+
+        //erase legacy watch
+        openballots.erase(ob);
+
+    }
+
+    //open seat watches table
+    seatwatches_table seatwatches(get_self(), ballot_name.value);
+    auto sw_itr = seatwatches.begin();
+
+    if (sw_itr == seatwatches.end()) {
+        return;
+    }
+
+    //open decide results table, get winners ranked at close
+    results_table results(decide_contract, decide_contract.value);
+    auto& res = results.get(ballot_name.value, "ballot results not found");
+
+    //assign winners to each watching committee's seats in rank order
+    while (sw_itr != seatwatches.end()) {
+
+        vector<pair<name, name>> assignments;
+        for (size_t i = 0; i < res.winners.size() && i < sw_itr->seat_names.size(); i++) {
+            assignments.push_back({ sw_itr->seat_names[i], res.winners[i] });
+        }
 
+        if (assignments.size() > 0) {
+            //requires get_self()@eosio.code to be under get_self()@active
+            action(permission_level{get_self(), name("active")}, decide_contract, name("assignseats"), make_tuple(
+                sw_itr->committee_name, //committee_name
+                sw_itr->treasury_symbol, //treasury_symbol
+                assignments, //assignments
+                std::string("auto-assigned from ballot results") //memo
+            )).send();
         }
+
+        //erase seat watch
+        sw_itr = seatwatches.erase(sw_itr);
+
     }
+
+}
+
+//======================== functions ========================
+
+name watcher::get_decide_contract() {
+
+    //open config singleton, get decide contract
+    config_singleton configs(get_self(), get_self().value);
+    return configs.get_or_default(config{ name("telos.decide") }).decide_contract;
+
+}
+
+uint128_t watcher::committee_key(name committee_name, symbol treasury_symbol) {
+
+    return (uint128_t(committee_name.value) << 64) | treasury_symbol.code().raw();
+
 }
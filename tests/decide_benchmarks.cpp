@@ -0,0 +1,291 @@
+#include <boost/test/unit_test.hpp>
+#include <eosio/testing/tester.hpp>
+#include <fc/variant_object.hpp>
+#include <eosio/chain/abi_serializer.hpp>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+
+#include "decide_tester.hpp"
+
+using namespace eosio;
+using namespace eosio::testing;
+using namespace eosio::chain;
+using namespace fc;
+using namespace std;
+using namespace decidetesting::testing;
+using mvo = fc::mutable_variant_object;
+
+//records resources billed by each benchmarked action and writes them as csv and json
+//disabled by default, run with --run_test=decide_benchmarks
+//reports are only written when DECIDE_BENCH_DIR is set to an output directory
+class benchmark_report {
+
+    public:
+
+    struct row {
+        string sweep;
+        string param;
+        string action;
+        int64_t elapsed_us;
+        uint32_t cpu_us;
+        uint64_t net_bytes;
+        int64_t ram_bytes;
+    };
+
+    static benchmark_report& get() {
+        static benchmark_report report;
+        return report;
+    }
+
+    void add(string sweep, string param, string action, const decide_tester::resource_usage& usage) {
+        rows.push_back(row{ sweep, param, action, usage.elapsed_us, usage.cpu_us, usage.net_bytes, usage.ram_bytes });
+    }
+
+    //rewrites report files with all rows recorded so far
+    void write() {
+        const char* dir = getenv("DECIDE_BENCH_DIR");
+        if (!dir) {
+            return;
+        }
+        string prefix = string(dir) + "/";
+
+        ofstream csv(prefix + "decide_benchmarks.csv");
+        csv << "sweep,param,action,elapsed_us,cpu_us,net_bytes,ram_bytes" << endl;
+        for (const auto& r : rows) {
+            csv << r.sweep << "," << r.param << "," << r.action << "," << r.elapsed_us << ","
+                << r.cpu_us << "," << r.net_bytes << "," << r.ram_bytes << endl;
+        }
+
+        ofstream json(prefix + "decide_benchmarks.json");
+        json << "[" << endl;
+        for (size_t i = 0; i < rows.size(); i++) {
+            const auto& r = rows[i];
+            json << "  {\"sweep\":\"" << r.sweep << "\",\"param\":\"" << r.param << "\",\"action\":\"" << r.action
+                << "\",\"elapsed_us\":" << r.elapsed_us << ",\"cpu_us\":" << r.cpu_us
+                << ",\"net_bytes\":" << r.net_bytes << ",\"ram_bytes\":" << r.ram_bytes << "}"
+                << (i + 1 < rows.size() ? "," : "") << endl;
+        }
+        json << "]" << endl;
+    }
+
+    private:
+
+    vector<row> rows;
+
+};
+
+//decide tester with a funded publisher and a public treasury voting with liquid balances
+class benchmark_tester : public decide_tester {
+
+    public:
+
+    const asset max_supply = asset::from_string("1000000000.00 BENCH");
+    const symbol treasury_symbol = max_supply.get_symbol();
+    const name manager = name("manager");
+    const name publisher = testa;
+
+    benchmark_tester() {
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+        base_tester::transfer(publisher, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        produce_blocks();
+    }
+
+    //creates voter accounts and mints them a balance, registering them on first credit
+    vector<name> make_voters(string prefix, uint32_t count) {
+        vector<name> voters = make_names(prefix, count);
+        create_accounts_with_resources(voters);
+        for (name v : voters) {
+            mint(manager, v, asset::from_string("100.00 BENCH"), "benchmark");
+        }
+        produce_blocks();
+        return voters;
+    }
+
+    void record(string sweep, string param, string action, transaction_trace_ptr trace) {
+        benchmark_report::get().add(sweep, param, action, get_resource_usage(trace));
+    }
+
+    //advances past the end time of ballots opened for a day
+    void finish_voting() {
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+    }
+
+};
+
+BOOST_AUTO_TEST_SUITE(decide_benchmarks, * boost::unit_test::disabled())
+
+    BOOST_FIXTURE_TEST_CASE( option_count_sweep, benchmark_tester ) try {
+
+        vector<name> voters = make_voters("ocv", 1);
+        vector<name> ballot_names = make_names("ocb", 4);
+        vector<uint32_t> option_counts = { 2, 5, 10, 20 };
+
+        for (size_t i = 0; i < option_counts.size(); i++) {
+            string param = "options=" + to_string(option_counts[i]);
+            vector<name> options = make_names("opt", option_counts[i]);
+
+            record("options", param, "newballot", new_ballot(ballot_names[i], name("poll"), publisher, treasury_symbol, name("1tokennvote"), options));
+            edit_min_max(publisher, ballot_names[i], 1, option_counts[i]);
+            record("options", param, "openvoting", open_voting(publisher, ballot_names[i], get_current_time_point_sec() + 86400));
+            record("options", param, "castvote", cast_vote(voters[0], ballot_names[i], options));
+            produce_blocks();
+        }
+
+        finish_voting();
+
+        for (size_t i = 0; i < option_counts.size(); i++) {
+            string param = "options=" + to_string(option_counts[i]);
+            record("options", param, "closevoting", close_ballot(publisher, ballot_names[i], false));
+            record("options", param, "cleanupvote", cleanup_vote(publisher, voters[0], ballot_names[i], {}));
+            produce_blocks();
+        }
+
+        benchmark_report::get().write();
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( content_size_sweep, benchmark_tester ) try {
+
+        vector<name> ballot_names = make_names("csb", 5);
+        vector<uint32_t> content_sizes = { 0, 128, 1024, 4096, 16384 };
+
+        for (size_t i = 0; i < content_sizes.size(); i++) {
+            string param = "content_bytes=" + to_string(content_sizes[i]);
+            string content(content_sizes[i], 'c');
+
+            record("content", param, "newballot", new_ballot(ballot_names[i], name("poll"), publisher, treasury_symbol, name("1tokennvote"), make_names("opt", 2)));
+            record("content", param, "editdetails", edit_details(publisher, ballot_names[i], "Benchmark Ballot", "", content));
+            produce_blocks();
+        }
+
+        benchmark_report::get().write();
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( voter_count_sweep, benchmark_tester ) try {
+
+        vector<name> voters = make_voters("vcv", 50);
+        vector<name> ballot_names = make_names("vcb", 3);
+        vector<uint32_t> voter_counts = { 5, 20, 50 };
+        vector<name> options = make_names("opt", 2);
+
+        for (size_t i = 0; i < voter_counts.size(); i++) {
+            string param = "voters=" + to_string(voter_counts[i]);
+
+            new_ballot(ballot_names[i], name("poll"), publisher, treasury_symbol, name("1tokennvote"), options);
+            open_voting(publisher, ballot_names[i], get_current_time_point_sec() + 86400);
+
+            for (uint32_t v = 0; v < voter_counts[i]; v++) {
+                record("voters", param, "castvote", cast_vote(voters[v], ballot_names[i], { options[v % 2] }));
+            }
+            produce_blocks();
+        }
+
+        finish_voting();
+
+        for (size_t i = 0; i < voter_counts.size(); i++) {
+            string param = "voters=" + to_string(voter_counts[i]);
+            record("voters", param, "closevoting", close_ballot(publisher, ballot_names[i], true));
+            produce_blocks();
+        }
+
+        benchmark_report::get().write();
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( voting_method_sweep, benchmark_tester ) try {
+
+        vector<name> voters = make_voters("vmv", 1);
+        vector<name> ballot_names = make_names("vmb", 5);
+        vector<name> methods = { name("1acct1vote"), name("1tokennvote"), name("1token1vote"), name("1tsquare1v"), name("quadratic") };
+        vector<name> options = make_names("opt", 3);
+
+        for (size_t i = 0; i < methods.size(); i++) {
+            string param = "method=" + methods[i].to_string();
+
+            new_ballot(ballot_names[i], name("poll"), publisher, treasury_symbol, methods[i], options);
+            edit_min_max(publisher, ballot_names[i], 1, 3);
+            open_voting(publisher, ballot_names[i], get_current_time_point_sec() + 86400);
+            record("method", param, "castvote", cast_vote(voters[0], ballot_names[i], options));
+            produce_blocks();
+        }
+
+        finish_voting();
+
+        for (size_t i = 0; i < methods.size(); i++) {
+            string param = "method=" + methods[i].to_string();
+            record("method", param, "closevoting", close_ballot(publisher, ballot_names[i], false));
+            produce_blocks();
+        }
+
+        benchmark_report::get().write();
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( light_ballot_sweep, benchmark_tester ) try {
+
+        vector<name> voters = make_voters("lbv", 10);
+        vector<name> ballot_names = make_names("lbb", 2);
+        vector<name> options = make_names("opt", 2);
+
+        for (size_t i = 0; i < ballot_names.size(); i++) {
+            string param = i == 0 ? "ballot=full" : "ballot=light";
+
+            new_ballot(ballot_names[i], name("poll"), publisher, treasury_symbol, name("1tokennvote"), options);
+            if (i == 1) {
+                toggle_bal(publisher, ballot_names[i], name("lightballot"));
+            }
+            open_voting(publisher, ballot_names[i], get_current_time_point_sec() + 86400);
+
+            for (name v : voters) {
+                record("light", param, "castvote", cast_vote(v, ballot_names[i], { options[0] }));
+            }
+            produce_blocks();
+        }
+
+        finish_voting();
+
+        for (size_t i = 0; i < ballot_names.size(); i++) {
+            string param = i == 0 ? "ballot=full" : "ballot=light";
+            record("light", param, "closevoting", close_ballot(publisher, ballot_names[i], false));
+            produce_blocks();
+        }
+
+        benchmark_report::get().write();
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( revote_sweep, benchmark_tester ) try {
+
+        vector<name> voters = make_voters("rvv", 1);
+        name ballot_name = name("revoteballot");
+        vector<name> options = make_names("opt", 4);
+
+        new_ballot(ballot_name, name("poll"), publisher, treasury_symbol, name("1tokennvote"), options);
+        edit_min_max(publisher, ballot_name, 1, 4);
+        open_voting(publisher, ballot_name, get_current_time_point_sec() + 86400);
+
+        record("revote", "votes=1", "castvote", cast_vote(voters[0], ballot_name, { options[0] }));
+        produce_blocks();
+
+        //revotes with growing selections
+        for (uint32_t n = 2; n <= 4; n++) {
+            vector<name> selections(options.begin(), options.begin() + n);
+            record("revote", "votes=" + to_string(n), "castvote", cast_vote(voters[0], ballot_name, selections));
+            produce_blocks();
+        }
+
+        record("revote", "votes=0", "unvoteall", unvote_all(voters[0], ballot_name));
+        produce_blocks();
+
+        benchmark_report::get().write();
+
+    } FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
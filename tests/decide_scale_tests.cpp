@@ -0,0 +1,267 @@
+#include <boost/test/unit_test.hpp>
+#include <eosio/testing/tester.hpp>
+#include <fc/variant_object.hpp>
+#include <eosio/chain/abi_serializer.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <limits>
+
+#include "decide_tester.hpp"
+
+using namespace eosio;
+using namespace eosio::testing;
+using namespace eosio::chain;
+using namespace fc;
+using namespace std;
+using namespace decidetesting::testing;
+using mvo = fc::mutable_variant_object;
+
+//drives telos decide with many voters and concurrent ballots on one chain
+//disabled by default, run with --run_test=decide_scale_tests
+//scale is read from the environment:
+//  DECIDE_SCALE_VOTERS         voters on the large ballot (default 2000)
+//  DECIDE_SCALE_BALLOTS        concurrent ballots (default 500)
+//  DECIDE_SCALE_BALLOT_VOTERS  voters on every concurrent ballot (default 10)
+//  DECIDE_SCALE_ACTIONS_PER_TRX, DECIDE_SCALE_TRXS_PER_BLOCK (default 20, 10)
+//  DECIDE_SCALE_CPU_US         per action cpu ceiling (unchecked if unset, cpu varies by machine)
+class scale_tester : public decide_tester {
+
+    public:
+
+    const asset max_supply = asset::from_string("1000000000.00 SCALE");
+    const symbol treasury_symbol = max_supply.get_symbol();
+    const name manager = name("manager");
+    const name publisher = testa;
+
+    const uint32_t actions_per_trx = env_param("DECIDE_SCALE_ACTIONS_PER_TRX", 20);
+    const uint32_t trxs_per_block = env_param("DECIDE_SCALE_TRXS_PER_BLOCK", 10);
+    const uint32_t max_cpu_us = env_param("DECIDE_SCALE_CPU_US", 0);
+
+    //per action net and ram ceilings, independent of scale
+    const uint64_t max_net_bytes = 512;
+    const int64_t max_ram_bytes = 1024;
+
+    scale_tester() {
+        //manager pays for voter rows and publisher pays for ballot rows
+        issue(eosio_name, eosio_name, asset::from_string("20000.0000 TLOS"), "scale ram");
+        create_account_with_resources(manager, eosio_name, asset::from_string("10000.0000 TLOS"), false);
+        push_action(eosio_name, name("buyram"), eosio_name, mvo()
+            ("payer", eosio_name)
+            ("receiver", publisher)
+            ("quant", asset::from_string("10000.0000 TLOS"))
+        );
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        produce_blocks();
+    }
+
+    static uint32_t env_param(const char* var, uint32_t default_value) {
+        const char* value = getenv(var);
+        return value ? uint32_t(stoul(value)) : default_value;
+    }
+
+    //creates voter accounts and mints them a balance in bulk
+    vector<name> make_voters(string prefix, uint32_t count) {
+        vector<name> voters = make_names(prefix, count);
+        create_accounts_bulk(voters, actions_per_trx, trxs_per_block);
+
+        vector<action> mints;
+        for (name v : voters) {
+            mints.push_back(decide_action(name("mint"), manager, mvo()
+                ("to", v)
+                ("quantity", asset::from_string("100.00 SCALE"))
+                ("memo", "scale")
+            ));
+        }
+        push_actions_bulk(mints, actions_per_trx, trxs_per_block);
+
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["voters"].as<uint32_t>(), count);
+        return voters;
+    }
+
+    action castvote_action(name voter, name ballot_name, vector<name> options) {
+        return decide_action(name("castvote"), voter, mvo()
+            ("voter", voter)
+            ("ballot_name", ballot_name)
+            ("options", options)
+        );
+    }
+
+    action cleanupvote_action(name voter, name ballot_name) {
+        return decide_action(name("cleanupvote"), publisher, mvo()
+            ("voter", voter)
+            ("ballot_name", ballot_name)
+            ("worker", fc::optional<name>())
+        );
+    }
+
+    //cpu is only checked when a ceiling is set
+    void require_ceiling(transaction_trace_ptr trace) {
+        uint32_t cpu_ceiling = max_cpu_us > 0 ? max_cpu_us : std::numeric_limits<uint32_t>::max();
+        require_resource_ceiling(trace, cpu_ceiling, max_net_bytes, max_ram_bytes);
+    }
+
+};
+
+BOOST_AUTO_TEST_SUITE(decide_scale_tests, * boost::unit_test::disabled())
+
+    BOOST_FIXTURE_TEST_CASE( many_voters_one_ballot, scale_tester ) try {
+
+        //initialize
+        uint32_t voter_count = max(env_param("DECIDE_SCALE_VOTERS", 2000), uint32_t(3));
+        name ballot_name = name("bigballot");
+        vector<name> options = { name("yes"), name("no"), name("abstain") };
+        vector<name> voters = make_voters("sv", voter_count);
+
+        base_tester::transfer(publisher, decide_name, "1000.0000 TLOS", "", token_name);
+        new_ballot(ballot_name, name("poll"), publisher, treasury_symbol, name("1tokennvote"), options);
+        open_voting(publisher, ballot_name, get_current_time_point_sec() + 86400);
+        produce_blocks();
+
+        //first vote opens the ballot's receipt scope, second is the baseline
+        require_ceiling(cast_vote(voters[0], ballot_name, { options[0] }));
+        auto early_vote = cast_vote(voters[1], ballot_name, { options[1] });
+        require_ceiling(early_vote);
+
+        //votes from every other voter but the last
+        vector<action> votes;
+        for (size_t i = 2; i + 1 < voters.size(); i++) {
+            votes.push_back(castvote_action(voters[i], ballot_name, { options[i % options.size()] }));
+        }
+        push_actions_bulk(votes, actions_per_trx, trxs_per_block);
+
+        //last vote costs the same as an early one
+        auto last_vote = cast_vote(voters.back(), ballot_name, { options[1] });
+        require_ceiling(last_vote);
+        BOOST_REQUIRE_EQUAL(get_resource_usage(last_vote).ram_bytes, get_resource_usage(early_vote).ram_bytes);
+        BOOST_REQUIRE_EQUAL(get_resource_usage(last_vote).net_bytes, get_resource_usage(early_vote).net_bytes);
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["total_voters"].as<uint32_t>(), voter_count);
+
+        //rebalance after balance change
+        mint(manager, voters.back(), asset::from_string("50.00 SCALE"), "scale");
+        produce_blocks();
+        require_ceiling(rebalance(publisher, voters.back(), ballot_name, {}));
+        produce_blocks();
+
+        //close after end time
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+        require_ceiling(close_ballot(publisher, ballot_name, false));
+        produce_blocks();
+
+        //cleanup every vote but the last
+        vector<action> cleanups;
+        for (size_t i = 0; i + 1 < voters.size(); i++) {
+            cleanups.push_back(cleanupvote_action(voters[i], ballot_name));
+        }
+        push_actions_bulk(cleanups, actions_per_trx, trxs_per_block);
+
+        require_ceiling(cleanup_vote(publisher, voters.back(), ballot_name, {}));
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["cleaned_count"].as<uint32_t>(), voter_count);
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( many_concurrent_ballots, scale_tester ) try {
+
+        //initialize
+        uint32_t ballot_count = env_param("DECIDE_SCALE_BALLOTS", 500);
+        uint32_t ballot_voter_count = env_param("DECIDE_SCALE_BALLOT_VOTERS", 10);
+        vector<name> options = { name("yes"), name("no") };
+        vector<name> voters = make_voters("cv", ballot_voter_count);
+        vector<name> ballot_names = make_names("cb", ballot_count);
+
+        //fund ballot fees
+        asset ballot_fee = variant_to_map<name, asset>(get_config()["fees"])[name("ballot")];
+        asset ballot_fees = asset(ballot_fee.get_amount() * int64_t(ballot_count), tlos_sym);
+        issue(eosio_name, publisher, ballot_fees, "ballot fees");
+        base_tester::transfer(publisher, decide_name, ballot_fees.to_string(), "", token_name);
+
+        //create and open ballots
+        vector<action> ballot_actions;
+        time_point_sec end_time = get_current_time_point_sec() + 86400;
+        for (name b : ballot_names) {
+            ballot_actions.push_back(decide_action(name("newballot"), publisher, mvo()
+                ("ballot_name", b)
+                ("category", name("poll"))
+                ("publisher", publisher)
+                ("treasury_symbol", treasury_symbol)
+                ("voting_method", name("1tokennvote"))
+                ("initial_options", options)
+            ));
+            ballot_actions.push_back(decide_action(name("openvoting"), publisher, mvo()
+                ("ballot_name", b)
+                ("end_time", end_time)
+            ));
+        }
+        push_actions_bulk(ballot_actions, actions_per_trx, trxs_per_block);
+
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["open_ballots"].as<uint32_t>(), ballot_count);
+
+        //every voter votes on every ballot but the last
+        vector<action> votes;
+        for (size_t b = 0; b + 1 < ballot_names.size(); b++) {
+            for (size_t v = 0; v < voters.size(); v++) {
+                votes.push_back(castvote_action(voters[v], ballot_names[b], { options[v % options.size()] }));
+            }
+        }
+        push_actions_bulk(votes, actions_per_trx, trxs_per_block);
+
+        //votes on the last ballot stay within ceilings with many live ballots
+        for (size_t v = 0; v < voters.size(); v++) {
+            require_ceiling(cast_vote(voters[v], ballot_names.back(), { options[v % options.size()] }));
+        }
+        produce_blocks();
+
+        //rebalance a voter with votes on every ballot
+        mint(manager, voters.front(), asset::from_string("50.00 SCALE"), "scale");
+        produce_blocks();
+        vector<action> rebalances;
+        for (size_t b = 0; b + 1 < ballot_names.size(); b++) {
+            rebalances.push_back(decide_action(name("rebalance"), publisher, mvo()
+                ("voter", voters.front())
+                ("ballot_name", ballot_names[b])
+                ("worker", fc::optional<name>())
+            ));
+        }
+        push_actions_bulk(rebalances, actions_per_trx, trxs_per_block);
+        require_ceiling(rebalance(publisher, voters.front(), ballot_names.back(), {}));
+        produce_blocks();
+
+        //close every ballot but the last
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        vector<action> closes;
+        for (size_t b = 0; b + 1 < ballot_names.size(); b++) {
+            closes.push_back(decide_action(name("closevoting"), publisher, mvo()
+                ("ballot_name", ballot_names[b])
+                ("broadcast", false)
+            ));
+        }
+        push_actions_bulk(closes, actions_per_trx, trxs_per_block);
+        require_ceiling(close_ballot(publisher, ballot_names.back(), false));
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["open_ballots"].as<uint32_t>(), 0);
+
+        //cleanup all votes
+        vector<action> cleanups;
+        for (size_t b = 0; b + 1 < ballot_names.size(); b++) {
+            for (name v : voters) {
+                cleanups.push_back(cleanupvote_action(v, ballot_names[b]));
+            }
+        }
+        push_actions_bulk(cleanups, actions_per_trx, trxs_per_block);
+
+        for (name v : voters) {
+            require_ceiling(cleanup_vote(publisher, v, ballot_names.back(), {}));
+        }
+        produce_blocks();
+
+    } FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
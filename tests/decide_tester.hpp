@@ -37,6 +37,7 @@ namespace decidetesting {
 
             //decide accounts
             const name decide_name = name("telos.decide");
+            const name watcher_name = name("watcher");
 
             //test accounts
             const name testa = name("testaccounta");
@@ -49,17 +50,34 @@ namespace decidetesting {
             //TABLE NAMEs
             const name config_tname = name("config");
             const name treasury_tname = name("treasuries");
+            const name trsstats_tname = name("trsstats");
             const name payroll_tname = name("payrolls");
             const name laborbucket_tname = name("laborbuckets");
             const name labors_tname = name("labors");
             const name ballots_tname = name("ballots");
+            const name ballotidx_tname = name("ballotidx");
+            const name baltemplates_tname = name("baltemplates");
+            const name blobs_tname = name("blobs");
+            const name metarefs_tname = name("metarefs");
+            const name zdetails_tname = name("zdetails");
+            const name subscribers_tname = name("subscribers");
+            const name notifypolicy_tname = name("notifypolicy");
+            const name notifyoptins_tname = name("notifyoptins");
             const name votes_tname = name("votes");
+            const name receipts_tname = name("receipts");
             const name voters_tname = name("voters");
+            const name balhistory_tname = name("balhistory");
+            const name merkleroots_tname = name("merkleroots");
+            const name nonces_tname = name("nonces");
             const name delegates_tname = name("delegates");
             const name committees_tname = name("committees");
+            const name heldseats_tname = name("heldseats");
             const name archivals_tname = name("archivals");
+            const name results_tname = name("results");
+            const name digests_tname = name("digests");
             const name featured_tname = name("featured");
             const name accounts_tname = name("accounts");
+            const name seatwatches_tname = name("seatwatches");
             
             //SYMBOLs
             const symbol tlos_sym = symbol(4, "TLOS");
@@ -67,6 +85,7 @@ namespace decidetesting {
 
             //ABI SERIALIZERs
             abi_serializer decide_abi_ser;
+            abi_serializer watcher_abi_ser;
             abi_serializer token_abi_ser;
             abi_serializer sys_abi_ser;
 
@@ -81,7 +100,7 @@ namespace decidetesting {
             decide_tester(setup_mode mode = setup_mode::full) {
 
                 //create contract accounts
-                create_accounts({ token_name, decide_name, rex_name, ram_name, ramfee_name, stake_name, bpay_name, vpay_name, names_name, trail_name });
+                create_accounts({ token_name, decide_name, rex_name, ram_name, ramfee_name, stake_name, bpay_name, vpay_name, names_name, trail_name, watcher_name });
 
                 //setup system and token contracts
                 setup_token_contract();
@@ -118,6 +137,14 @@ namespace decidetesting {
                     BOOST_REQUIRE_EQUAL(abi_serializer::to_abi(accnt.abi, abi), true);
                     decide_abi_ser.set_abi(abi, abi_serializer_max_time);
                 }
+                set_code( watcher_name, contracts::watcher_wasm());
+                set_abi( watcher_name, contracts::watcher_abi().data() );
+                {
+                    const auto& accnt = control->db().get<account_object,by_name>( watcher_name );
+                    abi_def abi;
+                    BOOST_REQUIRE_EQUAL(abi_serializer::to_abi(accnt.abi, abi), true);
+                    watcher_abi_ser.set_abi(abi, abi_serializer_max_time);
+                }
                 produce_blocks();
                 
                 if(mode == setup_mode::basic) return; 
@@ -329,6 +356,19 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //sets chain id used as signed vote domain
+            transaction_trace_ptr set_chain_id(fc::sha256 chain_id) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { decide_name, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("setchainid"), permissions, 
+                    mvo()
+                        ("chain_id", chain_id)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(decide_name, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //======================== treasury actions ========================
 
             //create a new treasury
@@ -490,6 +530,48 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //set treasury notify policy
+            transaction_trace_ptr set_notify(name manager, symbol treasury_symbol, name policy) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { manager, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("setnotify"), permissions, 
+                    mvo()
+                        ("treasury_symbol", treasury_symbol)
+                        ("policy", policy)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(manager, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //opt in to token action notifications
+            transaction_trace_ptr opt_in_notify(name account, symbol treasury_symbol) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { account, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("optinnotify"), permissions, 
+                    mvo()
+                        ("account", account)
+                        ("treasury_symbol", treasury_symbol)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(account, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //opt out of token action notifications
+            transaction_trace_ptr opt_out_notify(name account, symbol treasury_symbol) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { account, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("optoutnotify"), permissions, 
+                    mvo()
+                        ("account", account)
+                        ("treasury_symbol", treasury_symbol)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(account, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //======================== payroll actions ========================
 
             //adds to specified payroll
@@ -546,6 +628,67 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //creates and opens a ballot from a full ballot spec
+            transaction_trace_ptr new_ballot_full(name ballot_name, name publisher, mvo spec, time_point_sec end_time) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { publisher, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("newballotfull"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("publisher", publisher)
+                        ("spec", spec)
+                        ("end_time", end_time)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //creates or replaces a ballot template
+            transaction_trace_ptr set_template(name publisher, name template_name, mvo spec) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { publisher, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("settemplate"), permissions, 
+                    mvo()
+                        ("publisher", publisher)
+                        ("template_name", template_name)
+                        ("spec", spec)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //deletes a ballot template
+            transaction_trace_ptr del_template(name publisher, name template_name) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { publisher, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("deltemplate"), permissions, 
+                    mvo()
+                        ("publisher", publisher)
+                        ("template_name", template_name)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //creates and opens a ballot from a ballot template
+            transaction_trace_ptr new_from_tmpl(name ballot_name, name publisher, name template_name, time_point_sec end_time) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { publisher, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("newfromtmpl"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("publisher", publisher)
+                        ("template_name", template_name)
+                        ("end_time", end_time)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //edits ballots details
             transaction_trace_ptr edit_details(name publisher, name ballot_name, string title, string description, string content) {
                 signed_transaction trx;
@@ -562,6 +705,22 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //edits ballot details with compressed description and content
+            transaction_trace_ptr edit_details_z(name publisher, name ballot_name, string title, vector<char> description, vector<char> content) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { publisher, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("editdetailsz"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("title", title)
+                        ("description", description)
+                        ("content", content)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //toggles ballot settings
             transaction_trace_ptr toggle_bal(name publisher, name ballot_name, name setting_name) {
                 signed_transaction trx;
@@ -591,6 +750,20 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //sets number of winners on an election ballot
+            transaction_trace_ptr set_winners(name publisher, name ballot_name, uint8_t winners) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { publisher, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("setwinners"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("winners", winners)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //adds an option to a ballot
             transaction_trace_ptr add_option(name publisher, name ballot_name, name new_option_name) {
                 signed_transaction trx;
@@ -633,6 +806,21 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //readies a merkle ballot for voting
+            transaction_trace_ptr open_merkle(name publisher, name ballot_name, time_point_sec end_time, fc::sha256 merkle_root) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { publisher, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("openmerkle"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("end_time", end_time)
+                        ("merkle_root", merkle_root)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //cancels a ballot
             transaction_trace_ptr cancel_ballot(name publisher, name ballot_name, string memo) {
                 signed_transaction trx;
@@ -704,6 +892,39 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //subscribes a listener to a ballot broadcast
+            transaction_trace_ptr subscribe(name listener, name ballot_name) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { listener, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("subscribe"), permissions, 
+                    mvo()
+                        ("listener", listener)
+                        ("ballot_name", ballot_name)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(listener, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //unsubscribes a listener from a ballot broadcast
+            transaction_trace_ptr unsubscribe(name listener, name ballot_name) {
+                return unsubscribe(listener, listener, ballot_name);
+            }
+
+            //unsubscribes a listener from a ballot broadcast, authorized by listener or ballot publisher
+            transaction_trace_ptr unsubscribe(name authorizer, name listener, name ballot_name) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("unsubscribe"), permissions, 
+                    mvo()
+                        ("listener", listener)
+                        ("ballot_name", ballot_name)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //archives a ballot for a fee
             transaction_trace_ptr archive(name publisher, name ballot_name, time_point_sec archived_until) {
                 signed_transaction trx;
@@ -731,7 +952,21 @@ namespace decidetesting {
                 trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
                 return push_transaction( trx );
             }
-        
+
+
+            //archives a ballot as a compact digest
+            transaction_trace_ptr arch_digest(name publisher, name ballot_name, time_point_sec archived_until) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { publisher, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("archdigest"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("archived_until", archived_until)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }        
             //======================== voter actions ========================
 
             //registers a new voter
@@ -749,6 +984,21 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //registers many new voters
+            transaction_trace_ptr reg_voters(name authorizer, vector<name> voter_names, symbol treasury_symbol, fc::optional<name> referrer) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("regvoters"), permissions, 
+                    mvo()
+                        ("voter_names", voter_names)
+                        ("treasury_symbol", treasury_symbol)
+                        ("referrer", referrer)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //unregisters an existing voter
             transaction_trace_ptr unreg_voter(name voter, symbol treasury_symbol) {
                 signed_transaction trx;
@@ -778,6 +1028,80 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //casts a vote on a ballot by option index
+            transaction_trace_ptr cast_vote_idx(name voter, name ballot_name, vector<uint8_t> option_indexes) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { voter, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("castvoteidx"), permissions, 
+                    mvo()
+                        ("voter", voter)
+                        ("ballot_name", ballot_name)
+                        ("option_indexes", option_indexes)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(voter, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //casts a vote on a merkle ballot
+            transaction_trace_ptr cast_merkle(name voter, name ballot_name, vector<name> options, asset weight, vector<fc::sha256> proof) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { voter, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("castmerkle"), permissions, 
+                    mvo()
+                        ("voter", voter)
+                        ("ballot_name", ballot_name)
+                        ("options", options)
+                        ("weight", weight)
+                        ("proof", proof)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(voter, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //migrates legacy votes to receipts
+            transaction_trace_ptr migrate_votes(name authorizer, name ballot_name, uint16_t count) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("migratevotes"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("count", count)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //indexes ballots created before ballot indexes
+            transaction_trace_ptr index_ballots(name payer, uint16_t count) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { payer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("indexballots"), permissions, 
+                    mvo()
+                        ("payer", payer)
+                        ("count", count)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(payer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //casts a batch of votes signed off chain
+            transaction_trace_ptr cast_signed(name relayer, vector<mvo> votes) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { relayer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("castsigned"), permissions, 
+                    mvo()
+                        ("relayer", relayer)
+                        ("votes", votes)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(relayer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             // ACTION unvote(name voter, name ballot_name, name option_to_unvote);
 
             //rollback all votes on a ballot
@@ -822,6 +1146,65 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //registers voter as a delegate
+            transaction_trace_ptr reg_delegate(name delegate_name, symbol treasury_symbol) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { delegate_name, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("regdelegate"), permissions, 
+                    mvo()
+                        ("delegate_name", delegate_name)
+                        ("treasury_symbol", treasury_symbol)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(delegate_name, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //unregisters a delegate
+            transaction_trace_ptr unreg_delegate(name delegate_name, symbol treasury_symbol) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { delegate_name, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("unregdelegate"), permissions, 
+                    mvo()
+                        ("delegate_name", delegate_name)
+                        ("treasury_symbol", treasury_symbol)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(delegate_name, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //delegates voter's staked balance to a delegate
+            transaction_trace_ptr delegate(name voter, name delegate_name, symbol treasury_symbol, vector<name> ballot_names) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { voter, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("delegate"), permissions, 
+                    mvo()
+                        ("voter", voter)
+                        ("delegate_name", delegate_name)
+                        ("treasury_symbol", treasury_symbol)
+                        ("ballot_names", ballot_names)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(voter, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //returns voter's delegated balance from their delegate
+            transaction_trace_ptr undelegate(name voter, symbol treasury_symbol, vector<name> ballot_names) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { voter, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("undelegate"), permissions, 
+                    mvo()
+                        ("voter", voter)
+                        ("treasury_symbol", treasury_symbol)
+                        ("ballot_names", ballot_names)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(voter, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //======================== worker actions ========================
 
             //unregisters an existing worker
@@ -852,6 +1235,19 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //runs bounded maintenance work
+            transaction_trace_ptr tick(name authorizer, uint16_t max_work) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("tick"), permissions, 
+                    mvo()
+                        ("max_work", max_work)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //rebalance an unbalanced vote
             transaction_trace_ptr rebalance(name authorizer, name voter, name ballot_name, fc::optional<name> worker) {
                 signed_transaction trx;
@@ -964,6 +1360,56 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //assigns new members to many committee seats
+            transaction_trace_ptr assign_seats(name authorizer, name committee_name, symbol treasury_symbol, vector<pair<name, name>> assignments, string memo) {
+                vector<mvo> assignment_list;
+                for (auto& a : assignments) {
+                    assignment_list.push_back(mvo()("first", a.first)("second", a.second));
+                }
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("assignseats"), permissions, 
+                    mvo()
+                        ("committee_name", committee_name)
+                        ("treasury_symbol", treasury_symbol)
+                        ("assignments", assignment_list)
+                        ("memo", memo)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //vacates many committee seats
+            transaction_trace_ptr vacate_seats(name authorizer, name committee_name, symbol treasury_symbol, vector<name> seat_names, string memo) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("vacateseats"), permissions, 
+                    mvo()
+                        ("committee_name", committee_name)
+                        ("treasury_symbol", treasury_symbol)
+                        ("seat_names", seat_names)
+                        ("memo", memo)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //indexes current seat holders of a committee
+            transaction_trace_ptr sync_seats(name authorizer, name committee_name, symbol treasury_symbol) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(decide_name, name("syncseats"), permissions, 
+                    mvo()
+                        ("committee_name", committee_name)
+                        ("treasury_symbol", treasury_symbol)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
             //sets updater account and auth
             transaction_trace_ptr set_updater(vector<permission_level> permissions, name committee_name, symbol treasury_symbol, name updater_account, name updater_auth) {
                 signed_transaction trx;
@@ -997,6 +1443,38 @@ namespace decidetesting {
                 return push_transaction( trx );
             }
 
+            //======================== watcher actions ========================
+
+            //watches a ballot for a committee's seats
+            transaction_trace_ptr watch_seats(name authorizer, name ballot_name, symbol treasury_symbol, name committee_name, vector<name> seat_names) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(watcher_name, name("watchseats"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("treasury_symbol", treasury_symbol)
+                        ("committee_name", committee_name)
+                        ("seat_names", seat_names)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
+
+            //stops watching a ballot for a committee
+            transaction_trace_ptr unwatch(name authorizer, name ballot_name, symbol treasury_symbol, name committee_name) {
+                signed_transaction trx;
+                vector<permission_level> permissions { { authorizer, name("active") } };
+                trx.actions.emplace_back(get_action(watcher_name, name("unwatch"), permissions, 
+                    mvo()
+                        ("ballot_name", ballot_name)
+                        ("treasury_symbol", treasury_symbol)
+                        ("committee_name", committee_name)
+                ));
+                set_transaction_headers( trx );
+                trx.sign(get_private_key(authorizer, "active"), control->get_chain_id());
+                return push_transaction( trx );
+            }
 
             //======================== row getters  ========================
 
@@ -1010,6 +1488,11 @@ namespace decidetesting {
                 return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("treasury", data, abi_serializer_max_time);
             }
 
+            fc::variant get_trs_stats(symbol treasury_symbol) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, trsstats_tname, treasury_symbol.to_symbol_code());
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("treasury_stats", data, abi_serializer_max_time);
+            }
+
             fc::variant get_payroll(symbol treasury_symbol, name payroll_name) {
                 vector<char> data = get_row_by_account(decide_name, treasury_symbol.to_symbol_code(), payroll_tname, payroll_name);
                 return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("payroll", data, abi_serializer_max_time);
@@ -1035,11 +1518,31 @@ namespace decidetesting {
                 return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("vote", data, abi_serializer_max_time);
             }
 
+            fc::variant get_receipt(name ballot_name, name voter) {
+                vector<char> data = get_row_by_account(decide_name, ballot_name, receipts_tname, voter);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("receipt", data, abi_serializer_max_time);
+            }
+
             fc::variant get_voter(name voter, symbol vote_symbol) {
                 vector<char> data = get_row_by_account(decide_name, voter, voters_tname, vote_symbol.to_symbol_code());
                 return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("voter", data, abi_serializer_max_time);
             }
 
+            fc::variant get_balance_history(name voter, symbol treasury_symbol) {
+                vector<char> data = get_row_by_account(decide_name, voter, balhistory_tname, treasury_symbol.to_symbol_code());
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("balance_history", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_merkle_root(name ballot_name) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, merkleroots_tname, ballot_name);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("merkle_root", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_vote_nonce(name voter) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, nonces_tname, voter);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("vote_nonce", data, abi_serializer_max_time);
+            }
+
             fc::variant get_delegate(symbol treasury_symbol, name delegate_name) {
                 vector<char> data = get_row_by_account(decide_name, treasury_symbol.to_symbol_code(), delegates_tname, delegate_name);
                 return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("delegate", data, abi_serializer_max_time);
@@ -1050,16 +1553,78 @@ namespace decidetesting {
                 return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("committee", data, abi_serializer_max_time);
             }
 
+            fc::variant get_held_seats(name seat_holder, symbol treasury_symbol) {
+                vector<char> data = get_row_by_account(decide_name, seat_holder, heldseats_tname, name(treasury_symbol.to_symbol_code().value));
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("held_seats", data, abi_serializer_max_time);
+            }
+
             fc::variant get_archival(name ballot_name) {
                 vector<char> data = get_row_by_account(decide_name, decide_name, archivals_tname, ballot_name);
                 return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("archival", data, abi_serializer_max_time);
             }
 
+            fc::variant get_result(name ballot_name) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, results_tname, ballot_name);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("result", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_template(name publisher, name template_name) {
+                vector<char> data = get_row_by_account(decide_name, publisher, baltemplates_tname, template_name);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("ballot_template", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_blob(name publisher, fc::sha256 hash) {
+                uint64_t blob_id;
+                memcpy(&blob_id, hash.data(), sizeof(blob_id));
+                vector<char> data = get_row_by_account(decide_name, publisher, blobs_tname, name(blob_id));
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("blob", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_metaref(name ballot_name) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, metarefs_tname, ballot_name);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("metaref", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_zdetails(name ballot_name) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, zdetails_tname, ballot_name);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("packed_details", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_notify_policy(symbol treasury_symbol) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, notifypolicy_tname, name(treasury_symbol.to_symbol_code().value));
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("notify_policy", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_notify_optin(name account, symbol treasury_symbol) {
+                vector<char> data = get_row_by_account(decide_name, account, notifyoptins_tname, name(treasury_symbol.to_symbol_code().value));
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("notify_optin", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_subscriber(name ballot_name, name listener) {
+                vector<char> data = get_row_by_account(decide_name, ballot_name, subscribers_tname, listener);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("subscriber", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_ballot_index(name ballot_name) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, ballotidx_tname, ballot_name);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("ballot_index", data, abi_serializer_max_time);
+            }
+
+            fc::variant get_digest(name ballot_name) {
+                vector<char> data = get_row_by_account(decide_name, decide_name, digests_tname, ballot_name);
+                return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("ballot_digest", data, abi_serializer_max_time);
+            }
+
             fc::variant get_featured_ballot(symbol treasury_symbol, name ballot_name) {
                 vector<char> data = get_row_by_account(decide_name, treasury_symbol.to_symbol_code(), featured_tname, ballot_name);
                 return data.empty() ? fc::variant() : decide_abi_ser.binary_to_variant("featured_ballot", data, abi_serializer_max_time);
             }
 
+            fc::variant get_seat_watch(name ballot_name, uint64_t watch_id) {
+                vector<char> data = get_row_by_account(watcher_name, ballot_name, seatwatches_tname, name(watch_id));
+                return data.empty() ? fc::variant() : watcher_abi_ser.binary_to_variant("seat_watch", data, abi_serializer_max_time);
+            }
+
             //======================== system getters =======================
 
             fc::variant get_user_res(name account) {
@@ -1136,6 +1701,128 @@ namespace decidetesting {
                 return asset(tlos_asset.get_amount(), vote_sym);
             }
 
+            //======================== resource helpers =======================
+
+            struct resource_usage {
+                int64_t elapsed_us = 0; //time spent applying the transaction
+                uint32_t cpu_us = 0; //cpu billed in transaction receipt
+                uint64_t net_bytes = 0; //net billed
+                int64_t ram_bytes = 0; //sum of ram deltas across all accounts
+                map<name, int64_t> ram_deltas; //account -> ram delta
+            };
+
+            resource_usage get_resource_usage(transaction_trace_ptr trace) {
+                resource_usage usage;
+                usage.elapsed_us = trace->elapsed.count();
+                usage.net_bytes = trace->net_usage;
+                if (trace->receipt) {
+                    usage.cpu_us = trace->receipt->cpu_usage_us;
+                }
+                for (const auto& a_trace : trace->action_traces) {
+                    for (const auto& delta : a_trace.account_ram_deltas) {
+                        usage.ram_deltas[delta.account] += delta.delta;
+                        usage.ram_bytes += delta.delta;
+                    }
+                }
+                return usage;
+            }
+
+            //returns count unique names made of prefix (max 7 chars) and a 5 char index
+            vector<name> make_names(string prefix, uint32_t count) {
+                static const string chars = "abcdefghijklmnopqrstuvwxyz12345";
+                BOOST_REQUIRE(prefix.size() <= 7);
+                vector<name> names;
+                for (uint32_t i = 0; i < count; i++) {
+                    string suffix(5, 'a');
+                    uint32_t n = i;
+                    for (int k = 4; k >= 0; k--) {
+                        suffix[k] = chars[n % chars.size()];
+                        n /= chars.size();
+                    }
+                    names.push_back(name(prefix + suffix));
+                }
+                return names;
+            }
+
+            //======================== scale helpers =======================
+
+            //builds a decide action authorized by authorizer's active permission
+            action decide_action(name action_name, name authorizer, mvo data) {
+                return get_action(decide_name, action_name, { { authorizer, name("active") } }, data);
+            }
+
+            //pushes actions as one transaction signed by every authorizing account
+            transaction_trace_ptr push_actions(vector<action> actions) {
+                signed_transaction trx;
+                set<name> signers;
+                for (const auto& act : actions) {
+                    for (const auto& perm : act.authorization) {
+                        signers.insert(perm.actor);
+                    }
+                }
+                trx.actions = actions;
+                set_transaction_headers( trx );
+                for (name signer : signers) {
+                    trx.sign(get_private_key(signer, "active"), control->get_chain_id());
+                }
+                return push_transaction( trx );
+            }
+
+            //pushes actions packed actions_per_trx to a transaction, producing a block every trxs_per_block transactions
+            vector<transaction_trace_ptr> push_actions_bulk(const vector<action>& actions, uint32_t actions_per_trx, uint32_t trxs_per_block) {
+                vector<transaction_trace_ptr> traces;
+                for (size_t i = 0; i < actions.size(); i += actions_per_trx) {
+                    auto batch_end = actions.begin() + min(actions.size(), i + actions_per_trx);
+                    traces.push_back(push_actions(vector<action>(actions.begin() + i, batch_end)));
+                    if (traces.size() % trxs_per_block == 0) {
+                        produce_block();
+                    }
+                }
+                produce_blocks();
+                return traces;
+            }
+
+            //creates accounts with ram and bandwidth, packing accounts_per_trx account creations to a transaction
+            void create_accounts_bulk(vector<name> names, uint32_t accounts_per_trx, uint32_t trxs_per_block,
+                asset ramfunds = asset::from_string("100.0000 TLOS"), asset net = asset::from_string("10.0000 TLOS"), asset cpu = asset::from_string("10.0000 TLOS")) {
+
+                //issue enough tlos to fund every account
+                asset needed = asset((ramfunds.get_amount() + net.get_amount() + cpu.get_amount()) * int64_t(names.size()), tlos_sym);
+                issue(eosio_name, eosio_name, needed, "scale accounts");
+
+                vector<action> actions;
+                for (name a : names) {
+                    actions.emplace_back( vector<permission_level>{{eosio_name, config::active_name}},
+                        newaccount{
+                            .creator  = eosio_name,
+                            .name     = a,
+                            .owner    = authority( get_public_key( a, "owner" ) ),
+                            .active   = authority( get_public_key( a, "active" ) )
+                        });
+                    actions.push_back(get_action(eosio_name, name("buyram"), { { eosio_name, config::active_name } }, mvo()
+                        ("payer", eosio_name)
+                        ("receiver", a)
+                        ("quant", ramfunds)
+                    ));
+                    actions.push_back(get_action(eosio_name, name("delegatebw"), { { eosio_name, config::active_name } }, mvo()
+                        ("from", eosio_name)
+                        ("receiver", a)
+                        ("stake_net_quantity", net)
+                        ("stake_cpu_quantity", cpu)
+                        ("transfer", 1)
+                    ));
+                }
+                push_actions_bulk(actions, accounts_per_trx * 3, trxs_per_block);
+            }
+
+            //asserts resources billed to a single action transaction are within ceilings
+            void require_resource_ceiling(transaction_trace_ptr trace, uint32_t max_cpu_us, uint64_t max_net_bytes, int64_t max_ram_bytes) {
+                resource_usage usage = get_resource_usage(trace);
+                BOOST_REQUIRE_LE(usage.cpu_us, max_cpu_us);
+                BOOST_REQUIRE_LE(usage.net_bytes, max_net_bytes);
+                BOOST_REQUIRE_LE(usage.ram_bytes, max_ram_bytes);
+            }
+
             //======================== time helpers =======================
 
             uint64_t get_current_time() {
@@ -1246,6 +1933,114 @@ namespace decidetesting {
                 return payout;
             }
 
+            //======================== merkle helpers =======================
+
+            //leaf = sha256(0x00 || account || amount), matches decide::verify_merkle_proof()
+            fc::sha256 merkle_leaf(name account, asset weight) {
+                uint64_t account_value = account.to_uint64_t();
+                int64_t amount = weight.get_amount();
+                char data[17];
+                data[0] = 0x00;
+                memcpy(data + 1, &account_value, 8);
+                memcpy(data + 9, &amount, 8);
+                return fc::sha256::hash(data, sizeof(data));
+            }
+
+            //node = sha256(0x01 || lesser || greater)
+            fc::sha256 merkle_node(fc::sha256 lhs, fc::sha256 rhs) {
+                if (memcmp(rhs.data(), lhs.data(), 32) < 0) {
+                    std::swap(lhs, rhs);
+                }
+                char data[65];
+                data[0] = 0x01;
+                memcpy(data + 1, lhs.data(), 32);
+                memcpy(data + 33, rhs.data(), 32);
+                return fc::sha256::hash(data, sizeof(data));
+            }
+
+            //======================== signed vote helpers =======================
+
+            //builds a signed vote, digest = sha256(chain_id, contract, voter, ballot_name, options, nonce)
+            mvo make_signed_vote(name voter, name ballot_name, vector<name> options, uint64_t nonce, name signer) {
+                fc::sha256::encoder enc;
+                fc::raw::pack(enc, control->get_chain_id());
+                fc::raw::pack(enc, decide_name);
+                fc::raw::pack(enc, voter);
+                fc::raw::pack(enc, ballot_name);
+                fc::raw::pack(enc, options);
+                fc::raw::pack(enc, nonce);
+                fc::sha256 digest = enc.result();
+
+                return mvo()
+                    ("voter", voter)
+                    ("ballot_name", ballot_name)
+                    ("options", options)
+                    ("nonce", nonce)
+                    ("signing_key", get_public_key(signer, "active"))
+                    ("sig", get_private_key(signer, "active").sign(digest));
+            }
+
+            //======================== legacy state helpers =======================
+
+            //replaces voter's receipt with the equivalent legacy vote row written by decide v2.0.0
+            void set_legacy_vote(name ballot_name, name voter, asset raw_votes, vector<name> options) {
+                auto& db = const_cast<chainbase::database&>(control->db());
+                fc::variant rcpt = get_receipt(ballot_name, voter);
+                time_point_sec vote_time = rcpt["vote_time"].as<time_point_sec>();
+
+                //erase receipt
+                const auto& rcpt_tid = db.get<table_id_object, by_code_scope_table>(boost::make_tuple(decide_name, ballot_name, receipts_tname));
+                db.remove(db.get<key_value_object, by_scope_primary>(boost::make_tuple(rcpt_tid.id, voter.to_uint64_t())));
+                db.modify(rcpt_tid, [&](auto& t) { --t.count; });
+
+                //emplace legacy vote row and bytime index row
+                map<name, asset> weighted_votes;
+                for (name opt : options) {
+                    weighted_votes[opt] = raw_votes;
+                }
+                vector<char> data = decide_abi_ser.variant_to_binary("vote", mvo()
+                    ("voter", voter)
+                    ("is_delegate", rcpt["is_delegate"])
+                    ("raw_votes", raw_votes)
+                    ("weighted_votes", weighted_votes)
+                    ("vote_time", vote_time)
+                    ("worker", rcpt["worker"])
+                    ("rebalances", rcpt["rebalances"])
+                    ("rebalance_volume", asset(0, raw_votes.get_symbol())),
+                    abi_serializer_max_time
+                );
+
+                auto find_or_create_table = [&](name table) -> const table_id_object& {
+                    const auto* tid = db.find<table_id_object, by_code_scope_table>(boost::make_tuple(decide_name, ballot_name, table));
+                    if (tid == nullptr) {
+                        tid = &db.create<table_id_object>([&](auto& t) {
+                            t.code = decide_name;
+                            t.scope = ballot_name;
+                            t.table = table;
+                            t.payer = decide_name;
+                        });
+                    }
+                    db.modify(*tid, [&](auto& t) { ++t.count; });
+                    return *tid;
+                };
+
+                const auto& votes_tid = find_or_create_table(votes_tname);
+                db.create<key_value_object>([&](auto& obj) {
+                    obj.t_id = votes_tid.id;
+                    obj.primary_key = voter.to_uint64_t();
+                    obj.value.assign(data.data(), data.size());
+                    obj.payer = decide_name;
+                });
+
+                const auto& bytime_tid = find_or_create_table(name(votes_tname.to_uint64_t() & 0xFFFFFFFFFFFFFFF0ULL));
+                db.create<index64_object>([&](auto& obj) {
+                    obj.t_id = bytime_tid.id;
+                    obj.primary_key = voter.to_uint64_t();
+                    obj.secondary_key = vote_time.sec_since_epoch();
+                    obj.payer = decide_name;
+                });
+            }
+
             //======================== voting calculations =======================
 
             asset one_acct_one_vote_calc(asset raw_weight, symbol treasury_symbol) {
@@ -196,20 +196,23 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         validate_map(settings, name("unstakeable"), false);
 
         BOOST_REQUIRE_EQUAL(treasury["max_supply"].as<asset>(), max_supply);
-        BOOST_REQUIRE_EQUAL(treasury["supply"].as<asset>(), asset::from_string("0 DECIDE"));
         BOOST_REQUIRE_EQUAL(treasury["access"].as<name>(), name("public"));
         BOOST_REQUIRE_EQUAL(treasury["manager"].as<name>(), testa);
         BOOST_REQUIRE_EQUAL(treasury["title"], "");
         BOOST_REQUIRE_EQUAL(treasury["description"], "");
         BOOST_REQUIRE_EQUAL(treasury["icon"], "");
-        BOOST_REQUIRE_EQUAL(treasury["voters"], uint32_t(0));
-        BOOST_REQUIRE_EQUAL(treasury["delegates"], uint32_t(0));
-        BOOST_REQUIRE_EQUAL(treasury["committees"], uint32_t(0));
-        BOOST_REQUIRE_EQUAL(treasury["open_ballots"], uint32_t(0));
         BOOST_REQUIRE_EQUAL(treasury["locked"], false);
         BOOST_REQUIRE_EQUAL(treasury["unlock_acct"].as<name>(), testa);
         BOOST_REQUIRE_EQUAL(treasury["unlock_auth"].as<name>(), name("active"));
 
+        fc::variant stats = get_trs_stats(max_supply.get_symbol());
+
+        BOOST_REQUIRE_EQUAL(stats["supply"].as<asset>(), asset::from_string("0 DECIDE"));
+        BOOST_REQUIRE_EQUAL(stats["voters"], uint32_t(0));
+        BOOST_REQUIRE_EQUAL(stats["delegates"], uint32_t(0));
+        BOOST_REQUIRE_EQUAL(stats["committees"], uint32_t(0));
+        BOOST_REQUIRE_EQUAL(stats["open_ballots"], uint32_t(0));
+
         //flip all settings and validate
         toggle(testa, max_supply.get_symbol(), name("burnable"));
         toggle(testa, max_supply.get_symbol(), name("maxmutable"));
@@ -237,7 +240,7 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
 
         treasury = get_treasury(max_supply.get_symbol()).as<mvo>();
 
-        BOOST_REQUIRE_EQUAL(treasury["supply"].as<asset>(), max_supply - asset::from_string("1 DECIDE"));
+        BOOST_REQUIRE_EQUAL(get_trs_stats(max_supply.get_symbol())["supply"].as<asset>(), max_supply - asset::from_string("1 DECIDE"));
 
         validate_voter(testb, max_supply.get_symbol(), mvo()
             ("liquid", max_supply - asset::from_string("1 DECIDE"))
@@ -252,25 +255,13 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
             eosio_assert_message_exception, eosio_assert_message_is( "minting would breach max supply" ) 
         );
 
-        BOOST_REQUIRE_EXCEPTION(transfer(testb, testc, asset::from_string("1000 DECIDE"), "should fail, testc isn't registered"), 
-            eosio_assert_message_exception, eosio_assert_message_is( "add_liquid: voter not found" ) 
-        );
-
         produce_blocks();
 
-        reg_voter(testc, max_supply.get_symbol(), {});
-
-        validate_voter(testc, max_supply.get_symbol(), mvo()
-            ("liquid", asset::from_string("0 DECIDE"))
-            ("staked", "0 DECIDE")
-            ("staked_time", time_point_sec(get_current_time_point()))
-            ("delegated", "0 DECIDE")
-            ("delegated_to", "")
-            ("delegation_time", time_point_sec(get_current_time_point()))
-        );
+        //transfer to unregistered testc on a public treasury registers testc
+        auto trace = transfer(testb, testc, asset::from_string("1000 DECIDE"), "");
 
-        //transfer to testc should succeed now that the account is registered
-        transfer(testb, testc, asset::from_string("1000 DECIDE"), "");
+        validate_action_payer(trace, decide_name, name("transfer"), testb);
+        BOOST_REQUIRE_EQUAL(get_trs_stats(max_supply.get_symbol())["voters"].as<uint32_t>(), 2);
 
         validate_voter(testc, max_supply.get_symbol(), mvo()
             ("liquid", asset::from_string("1000 DECIDE"))
@@ -287,7 +278,7 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         );
 
         //register testa to its own treasury
-        auto trace = reg_voter(testa, max_supply.get_symbol(), {});
+        trace = reg_voter(testa, max_supply.get_symbol(), {});
 
         validate_action_payer(trace, decide_name, name("regvoter"), testa);
 
@@ -334,7 +325,7 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
 
         treasury = get_treasury(max_supply.get_symbol()).as<mvo>();
 
-        BOOST_REQUIRE_EQUAL(treasury["supply"].as<asset>(), max_supply - asset::from_string("1 DECIDE") - asset::from_string("100 DECIDE"));
+        BOOST_REQUIRE_EQUAL(get_trs_stats(max_supply.get_symbol())["supply"].as<asset>(), max_supply - asset::from_string("1 DECIDE") - asset::from_string("100 DECIDE"));
         asset new_max_supply = max_supply - asset::from_string("100 DECIDE");
         mutate_max(testa, new_max_supply, "");
 
@@ -631,14 +622,14 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
 
 
         //then cancel
-        fc::variant treasury_info = get_treasury(treasury_symbol);
+        fc::variant treasury_info = get_trs_stats(treasury_symbol);
         BOOST_REQUIRE_EQUAL(treasury_info["open_ballots"].as<uint32_t>(), uint32_t(1));
 
         cancel_ballot(voter1, ballot_name, "because nevermind");
         ballot_info = get_ballot(ballot_name);
         BOOST_REQUIRE_EQUAL(ballot_info["status"].as<name>(), name("cancelled"));
 
-        treasury_info = get_treasury(treasury_symbol);
+        treasury_info = get_trs_stats(treasury_symbol);
         BOOST_REQUIRE_EQUAL(treasury_info["open_ballots"].as<uint32_t>(), uint32_t(0));
         
         //then delete
@@ -716,6 +707,17 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EXCEPTION(add_option(voter1, ballot_name, name("options3")), 
             eosio_assert_message_exception, eosio_assert_message_is( "ballot must be in setup mode to add options" ) 
         );
+
+        //receipts index options with uint8, so ballots are capped at 256 options
+        vector<name> many_options = make_names("opt", 257);
+        BOOST_REQUIRE_EXCEPTION(new_ballot(name("ballot2"), category, voter1, treasury_symbol, voting_method, many_options), 
+            eosio_assert_message_exception, eosio_assert_message_is( "ballot cannot have more than 256 options" ) 
+        );
+
+        new_ballot(name("ballot2"), category, voter1, treasury_symbol, voting_method, vector<name>(many_options.begin(), many_options.begin() + 256));
+        BOOST_REQUIRE_EXCEPTION(add_option(voter1, name("ballot2"), many_options.back()), 
+            eosio_assert_message_exception, eosio_assert_message_is( "ballot cannot have more than 256 options" ) 
+        );
     } FC_LOG_AND_RETHROW()
 
     BOOST_FIXTURE_TEST_CASE( committee_basics, decide_tester ) try {
@@ -970,10 +972,9 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EQUAL(option_map[option1], one_acct_one_vote_calc(raw_vote_weight, treasury_symbol));
         BOOST_REQUIRE_EQUAL(option_map[option2], one_acct_one_vote_calc(raw_vote_weight, treasury_symbol));
 
-        fc::variant vote_info = get_vote(one_account_one_vote, voter1);
-        option_map = variant_to_map<name, asset>(vote_info["weighted_votes"]);
-        BOOST_REQUIRE_EQUAL(option_map[option1], one_acct_one_vote_calc(raw_vote_weight, treasury_symbol));
-        BOOST_REQUIRE_EQUAL(option_map[option2], one_acct_one_vote_calc(raw_vote_weight, treasury_symbol));
+        fc::variant vote_info = get_receipt(one_account_one_vote, voter1);
+        BOOST_REQUIRE_EQUAL(vote_info["raw_votes"].as<int64_t>(), raw_vote_weight.get_amount());
+        BOOST_REQUIRE(vote_info["selections"].as<vector<uint8_t>>() == vector<uint8_t>({ 0, 1 }));
         
 
         //one_account_n_votes testing
@@ -990,10 +991,9 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EQUAL(option_map[option1], one_token_n_vote_calc(raw_vote_weight, treasury_symbol));
         BOOST_REQUIRE_EQUAL(option_map[option2], one_token_n_vote_calc(raw_vote_weight, treasury_symbol));
 
-        vote_info = get_vote(one_token_n_vote, voter1);
-        option_map = variant_to_map<name, asset>(vote_info["weighted_votes"]);
-        BOOST_REQUIRE_EQUAL(option_map[option1], one_token_n_vote_calc(raw_vote_weight, treasury_symbol));
-        BOOST_REQUIRE_EQUAL(option_map[option2], one_token_n_vote_calc(raw_vote_weight, treasury_symbol));
+        vote_info = get_receipt(one_token_n_vote, voter1);
+        BOOST_REQUIRE_EQUAL(vote_info["raw_votes"].as<int64_t>(), raw_vote_weight.get_amount());
+        BOOST_REQUIRE(vote_info["selections"].as<vector<uint8_t>>() == vector<uint8_t>({ 0, 1 }));
 
 
 
@@ -1010,10 +1010,9 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EQUAL(option_map[option1], one_token_one_vote_calc(raw_vote_weight, treasury_symbol, 2));
         BOOST_REQUIRE_EQUAL(option_map[option2], one_token_one_vote_calc(raw_vote_weight, treasury_symbol, 2));
 
-        vote_info = get_vote(one_token_one_vote, voter1);
-        option_map = variant_to_map<name, asset>(vote_info["weighted_votes"]);
-        BOOST_REQUIRE_EQUAL(option_map[option1], one_token_one_vote_calc(raw_vote_weight, treasury_symbol, 2));
-        BOOST_REQUIRE_EQUAL(option_map[option2], one_token_one_vote_calc(raw_vote_weight, treasury_symbol, 2));
+        vote_info = get_receipt(one_token_one_vote, voter1);
+        BOOST_REQUIRE_EQUAL(vote_info["raw_votes"].as<int64_t>(), raw_vote_weight.get_amount());
+        BOOST_REQUIRE(vote_info["selections"].as<vector<uint8_t>>() == vector<uint8_t>({ 0, 1 }));
 
 
 
@@ -1030,10 +1029,9 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EQUAL(option_map[option1], one_t_square_one_vote_calc(raw_vote_weight, treasury_symbol, 2));
         BOOST_REQUIRE_EQUAL(option_map[option2], one_t_square_one_vote_calc(raw_vote_weight, treasury_symbol, 2));
 
-        vote_info = get_vote(one_token_square_one_vote, voter1);
-        option_map = variant_to_map<name, asset>(vote_info["weighted_votes"]);
-        BOOST_REQUIRE_EQUAL(option_map[option1], one_t_square_one_vote_calc(raw_vote_weight, treasury_symbol, 2));
-        BOOST_REQUIRE_EQUAL(option_map[option2], one_t_square_one_vote_calc(raw_vote_weight, treasury_symbol, 2));
+        vote_info = get_receipt(one_token_square_one_vote, voter1);
+        BOOST_REQUIRE_EQUAL(vote_info["raw_votes"].as<int64_t>(), raw_vote_weight.get_amount());
+        BOOST_REQUIRE(vote_info["selections"].as<vector<uint8_t>>() == vector<uint8_t>({ 0, 1 }));
 
 
         //quadratic testing
@@ -1049,10 +1047,9 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EQUAL(option_map[option1], quadratic_calc(raw_vote_weight, treasury_symbol));
         BOOST_REQUIRE_EQUAL(option_map[option2], quadratic_calc(raw_vote_weight, treasury_symbol));
 
-        vote_info = get_vote(quadratic, voter1);
-        option_map = variant_to_map<name, asset>(vote_info["weighted_votes"]);
-        BOOST_REQUIRE_EQUAL(option_map[option1], quadratic_calc(raw_vote_weight, treasury_symbol));
-        BOOST_REQUIRE_EQUAL(option_map[option2], quadratic_calc(raw_vote_weight, treasury_symbol));
+        vote_info = get_receipt(quadratic, voter1);
+        BOOST_REQUIRE_EQUAL(vote_info["raw_votes"].as<int64_t>(), raw_vote_weight.get_amount());
+        BOOST_REQUIRE(vote_info["selections"].as<vector<uint8_t>>() == vector<uint8_t>({ 0, 1 }));
     } FC_LOG_AND_RETHROW()
 
     BOOST_FIXTURE_TEST_CASE( worker_basics, decide_tester ) try {
@@ -1128,10 +1125,8 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EQUAL(option_map[option1], tlos_to_vote(initial_stake));
         BOOST_REQUIRE_EQUAL(option_map[option2], tlos_to_vote(initial_stake));
 
-        //vote quantities should be unchanged
-        option_map = variant_to_map<name, asset>(get_vote(ballot_name, voter1)["weighted_votes"]);
-        BOOST_REQUIRE_EQUAL(option_map[option1], tlos_to_vote(initial_stake));
-        BOOST_REQUIRE_EQUAL(option_map[option2], tlos_to_vote(initial_stake));
+        //receipt raw votes should be unchanged
+        BOOST_REQUIRE_EQUAL(get_receipt(ballot_name, voter1)["raw_votes"].as<int64_t>(), tlos_to_vote(initial_stake).get_amount());
 
         //validate that user stake and voter stake has changed
         user_resource_info = get_user_res(voter1);
@@ -1168,10 +1163,21 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EQUAL(option_map[option1], tlos_to_vote(current_stake));
         BOOST_REQUIRE_EQUAL(option_map[option2], tlos_to_vote(current_stake));
 
-        //vote quantities should be changed to current stake in VOTE
-        option_map = variant_to_map<name, asset>(get_vote(ballot_name, voter1)["weighted_votes"]);
-        BOOST_REQUIRE_EQUAL(option_map[option1], tlos_to_vote(current_stake));
-        BOOST_REQUIRE_EQUAL(option_map[option2], tlos_to_vote(current_stake));
+        //receipt raw votes should be changed to current stake in VOTE
+        fc::variant receipt_info = get_receipt(ballot_name, voter1);
+        BOOST_REQUIRE_EQUAL(receipt_info["raw_votes"].as<int64_t>(), tlos_to_vote(current_stake).get_amount());
+        BOOST_REQUIRE_EQUAL(receipt_info["rebalances"].as<uint8_t>(), 1);
+        BOOST_REQUIRE_EQUAL(receipt_info["worker"].as<name>(), worker);
+
+        //only publisher can migrate votes
+        BOOST_REQUIRE_EXCEPTION(migrate_votes(worker, ballot_name, 10), 
+            missing_auth_exception, eosio::testing::fc_exception_message_starts_with( "missing authority" ) 
+        );
+
+        //no legacy votes left to migrate
+        BOOST_REQUIRE_EXCEPTION(migrate_votes(voter1, ballot_name, 10), 
+            eosio_assert_message_exception, eosio_assert_message_is( "no legacy votes to migrate" ) 
+        );
 
         //get labor, should still be null, because rebalances are logged at the same time as cleaning
         BOOST_REQUIRE(get_labor(treasury_symbol, worker).is_null());
@@ -1188,7 +1194,7 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         //claim payment for work done
         cleanup_vote(worker, voter1, ballot_name, worker);
 
-        BOOST_REQUIRE(get_vote(ballot_name, voter1).is_null());
+        BOOST_REQUIRE(get_receipt(ballot_name, voter1).is_null());
 
         fc::variant labor_info = get_labor(treasury_symbol, worker);
         BOOST_REQUIRE_EQUAL(labor_info["worker_name"].as<name>(), worker);
@@ -1370,5 +1376,1678 @@ BOOST_AUTO_TEST_SUITE(decide_tests)
         BOOST_REQUIRE_EQUAL(payroll["claimable_pay"].as<asset>(), asset::from_string("1000.0000 TLOS") - worker_pay - worker1_pay - worker2_pay);
 
     } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( migrated_revote, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name publisher = testa, voter = testb;
+        asset weight = asset::from_string("1000.00 GOO");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(publisher, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(publisher, treasury_symbol, {});
+        reg_voter(voter, treasury_symbol, {});
+        mint(manager, voter, weight, "init amount");
+
+        new_ballot(ballot_name, category, publisher, treasury_symbol, voting_method, { option1, option2 });
+        edit_min_max(publisher, ballot_name, 1, 2);
+        open_voting(publisher, ballot_name, get_current_time_point_sec() + 86400);
+        produce_blocks();
+
+        //vote, then rewrite receipt as a legacy vote
+        cast_vote(voter, ballot_name, { option1 });
+        set_legacy_vote(ballot_name, voter, weight, { option1 });
+        produce_blocks();
+
+        BOOST_REQUIRE(get_receipt(ballot_name, voter).is_null());
+
+        //publisher migrates legacy vote, receipt is billed to publisher
+        migrate_votes(publisher, ballot_name, 10);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_receipt(ballot_name, voter)["selections"].as<vector<uint8_t>>() == vector<uint8_t>({ 0 }));
+
+        //revote with more options grows receipt, moving it to voter
+        cast_vote(voter, ballot_name, { option1, option2 });
+        produce_blocks();
+
+        BOOST_REQUIRE(get_receipt(ballot_name, voter)["selections"].as<vector<uint8_t>>() == vector<uint8_t>({ 0, 1 }));
+
+        map<name, asset> option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], weight);
+        BOOST_REQUIRE_EQUAL(option_map[option2], weight);
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["total_voters"].as<uint32_t>(), 1);
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( snapshot_voting, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name voter1 = testa, voter2 = testb;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        toggle(manager, treasury_symbol, name("transferable"));
+
+        reg_voter(voter1, treasury_symbol, {});
+        reg_voter(voter2, treasury_symbol, {});
+
+        mint(manager, voter1, asset::from_string("1000.00 GOO"), "init amount");
+        mint(manager, voter2, asset::from_string("1000.00 GOO"), "init amount");
+
+        //no history is logged on a treasury without snapshot ballots
+        BOOST_REQUIRE(get_balance_history(voter1, treasury_symbol).is_null());
+        BOOST_REQUIRE(get_balance_history(voter2, treasury_symbol).is_null());
+
+        produce_block(fc::seconds(2));
+        transfer(voter1, voter2, asset::from_string("100.00 GOO"), "churn");
+        produce_block(fc::seconds(2));
+        transfer(voter2, voter1, asset::from_string("100.00 GOO"), "churn");
+        produce_blocks();
+
+        BOOST_REQUIRE(get_balance_history(voter1, treasury_symbol).is_null());
+        BOOST_REQUIRE(get_balance_history(voter2, treasury_symbol).is_null());
+
+        //create snapshot ballot
+        new_ballot(ballot_name, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+        toggle_bal(voter1, ballot_name, name("votesnapshot"));
+
+        validate_map(variant_to_map<name, bool>(get_ballot(ballot_name)["settings"]), name("votesnapshot"), true);
+
+        //snapshot ballots can't outlive the checkpoint window
+        uint32_t window = variant_to_map<name, uint32_t>(get_config()["times"])[name("chkptwindow")];
+        BOOST_REQUIRE_EXCEPTION(open_voting(voter1, ballot_name, get_current_time_point_sec() + window + 10), 
+            eosio_assert_message_exception, eosio_assert_message_is( "snapshot ballot cannot be open longer than checkpoint window" ) 
+        );
+
+        open_voting(voter1, ballot_name, get_current_time_point_sec() + 86400);
+        produce_block(fc::seconds(2));
+        produce_blocks();
+
+        //balances change after voting opens
+        transfer(voter2, voter1, asset::from_string("500.00 GOO"), "after snapshot");
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_voter(voter1, treasury_symbol)["liquid"].as<asset>(), asset::from_string("1500.00 GOO"));
+        BOOST_REQUIRE_EQUAL(get_voter(voter2, treasury_symbol)["liquid"].as<asset>(), asset::from_string("500.00 GOO"));
+
+        //first change after snapshot seeds history with prior balance
+        vector<fc::variant> checkpoints = get_balance_history(voter1, treasury_symbol)["checkpoints"].as<vector<fc::variant>>();
+        BOOST_REQUIRE_EQUAL(checkpoints.size(), 2);
+        BOOST_REQUIRE_EQUAL(checkpoints[0]["liquid"].as<int64_t>(), 100000);
+        BOOST_REQUIRE_EQUAL(checkpoints[1]["liquid"].as<int64_t>(), 150000);
+
+        //checkpoints after snapshot began merge, checkpoint read by snapshot ballot is kept
+        produce_block(fc::seconds(2));
+        transfer(voter1, voter2, asset::from_string("100.00 GOO"), "churn");
+        produce_block(fc::seconds(2));
+        transfer(voter2, voter1, asset::from_string("100.00 GOO"), "churn");
+        produce_blocks();
+
+        checkpoints = get_balance_history(voter1, treasury_symbol)["checkpoints"].as<vector<fc::variant>>();
+        BOOST_REQUIRE_EQUAL(checkpoints.size(), 2);
+        BOOST_REQUIRE_EQUAL(checkpoints[0]["liquid"].as<int64_t>(), 100000);
+        BOOST_REQUIRE_EQUAL(checkpoints[1]["liquid"].as<int64_t>(), 150000);
+
+        cast_vote(voter1, ballot_name, { option1 });
+        cast_vote(voter2, ballot_name, { option2 });
+
+        //votes are weighted by balance at ballot begin time
+        map<name, asset> option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("1000.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option2], asset::from_string("1000.00 GOO"));
+
+        BOOST_REQUIRE_EXCEPTION(rebalance(voter1, voter1, ballot_name, {}), 
+            eosio_assert_message_exception, eosio_assert_message_is( "snapshot ballot votes never need rebalancing" ) 
+        );
+
+        //changes after checkpoint window passes aren't logged
+        produce_block(fc::seconds(window + 10));
+        transfer(voter1, voter2, asset::from_string("500.00 GOO"), "after window");
+        produce_blocks();
+
+        checkpoints = get_balance_history(voter1, treasury_symbol)["checkpoints"].as<vector<fc::variant>>();
+        BOOST_REQUIRE_EQUAL(checkpoints.size(), 2);
+        BOOST_REQUIRE_EQUAL(checkpoints[1]["liquid"].as<int64_t>(), 150000);
+
+        //stale history is ignored by next snapshot ballot
+        name ballot_name2 = name("ballot2");
+        new_ballot(ballot_name2, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+        toggle_bal(voter1, ballot_name2, name("votesnapshot"));
+        open_voting(voter1, ballot_name2, get_current_time_point_sec() + 86400);
+        produce_blocks();
+
+        cast_vote(voter1, ballot_name2, { option1 });
+
+        option_map = variant_to_map<name, asset>(get_ballot(ballot_name2)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("1000.00 GOO"));
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( merkle_voting, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name voter1 = testa, voter2 = testb;
+        asset weight1 = asset::from_string("1000.00 GOO");
+        asset weight2 = asset::from_string("250.00 GOO");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(voter1, treasury_symbol, {});
+
+        //build two leaf merkle tree off chain
+        fc::sha256 leaf1 = merkle_leaf(voter1, weight1);
+        fc::sha256 leaf2 = merkle_leaf(voter2, weight2);
+        fc::sha256 root = merkle_node(leaf1, leaf2);
+
+        new_ballot(ballot_name, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+
+        BOOST_REQUIRE_EXCEPTION(open_merkle(voter1, ballot_name, get_current_time_point_sec() + 86400, fc::sha256()), 
+            eosio_assert_message_exception, eosio_assert_message_is( "merkle root cannot be empty" ) 
+        );
+
+        open_merkle(voter1, ballot_name, get_current_time_point_sec() + 86400, root);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_merkle_root(ballot_name)["root"].as<fc::sha256>(), root);
+        validate_map(variant_to_map<name, bool>(get_ballot(ballot_name)["settings"]), name("merklevote"), true);
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["status"].as<name>(), name("voting"));
+
+        //merkle ballots don't read live balances
+        BOOST_REQUIRE_EXCEPTION(cast_vote(voter1, ballot_name, { option1 }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "votes on merkle ballot must be cast with castmerkle" ) 
+        );
+
+        //proofs must match committed root
+        BOOST_REQUIRE_EXCEPTION(cast_merkle(voter1, ballot_name, { option1 }, asset::from_string("2000.00 GOO"), { leaf2 }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "invalid merkle proof" ) 
+        );
+        BOOST_REQUIRE_EXCEPTION(cast_merkle(voter2, ballot_name, { option2 }, weight2, { leaf2 }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "invalid merkle proof" ) 
+        );
+
+        //voter2 never registered, proof is enough
+        cast_merkle(voter1, ballot_name, { option1 }, weight1, { leaf2 });
+        cast_merkle(voter2, ballot_name, { option2 }, weight2, { leaf1 });
+        produce_blocks();
+
+        fc::variant ballot_info = get_ballot(ballot_name);
+        map<name, asset> option_map = variant_to_map<name, asset>(ballot_info["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], weight1);
+        BOOST_REQUIRE_EQUAL(option_map[option2], weight2);
+        BOOST_REQUIRE_EQUAL(ballot_info["total_voters"].as<uint32_t>(), 2);
+        BOOST_REQUIRE_EQUAL(ballot_info["total_raw_weight"].as<asset>(), weight1 + weight2);
+
+        BOOST_REQUIRE_EXCEPTION(rebalance(voter1, voter1, ballot_name, {}), 
+            eosio_assert_message_exception, eosio_assert_message_is( "merkle ballot votes never need rebalancing" ) 
+        );
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( signed_voting, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name relayer = testc;
+        name voter1 = testa, voter2 = testb;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        toggle(manager, treasury_symbol, name("stakeable"));
+
+        reg_voter(voter1, treasury_symbol, {});
+        reg_voter(voter2, treasury_symbol, {});
+
+        mint(manager, voter1, asset::from_string("1000.00 GOO"), "init amount");
+        mint(manager, voter2, asset::from_string("400.00 GOO"), "init amount");
+        stake(voter1, asset::from_string("1000.00 GOO"));
+        stake(voter2, asset::from_string("400.00 GOO"));
+
+        new_ballot(ballot_name, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+        open_voting(voter1, ballot_name, get_current_time_point_sec() + 86400);
+        produce_blocks();
+
+        //chain id must be set before relaying
+        BOOST_REQUIRE_EXCEPTION(cast_signed(relayer, { make_signed_vote(voter1, ballot_name, { option1 }, 1, voter1) }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "chain id not set" ) 
+        );
+
+        set_chain_id(control->get_chain_id());
+        produce_blocks();
+
+        //signer must hold voter's active permission
+        BOOST_REQUIRE_EXCEPTION(cast_signed(relayer, { make_signed_vote(voter1, ballot_name, { option1 }, 1, voter2) }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "signing key does not satisfy voter's active permission" ) 
+        );
+
+        //relay both votes in one action
+        cast_signed(relayer, { 
+            make_signed_vote(voter1, ballot_name, { option1 }, 1, voter1),
+            make_signed_vote(voter2, ballot_name, { option2 }, 7, voter2)
+        });
+        produce_blocks();
+
+        fc::variant ballot_info = get_ballot(ballot_name);
+        map<name, asset> option_map = variant_to_map<name, asset>(ballot_info["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("1000.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option2], asset::from_string("400.00 GOO"));
+        BOOST_REQUIRE_EQUAL(ballot_info["total_voters"].as<uint32_t>(), 2);
+
+        BOOST_REQUIRE_EQUAL(get_vote_nonce(voter1)["last_nonce"].as<uint64_t>(), 1);
+        BOOST_REQUIRE_EQUAL(get_vote_nonce(voter2)["last_nonce"].as<uint64_t>(), 7);
+
+        //replayed vote is rejected
+        BOOST_REQUIRE_EXCEPTION(cast_signed(relayer, { make_signed_vote(voter2, ballot_name, { option1 }, 7, voter2) }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "nonce already used" ) 
+        );
+
+        //revote with higher nonce
+        cast_signed(relayer, { make_signed_vote(voter2, ballot_name, { option1 }, 8, voter2) });
+        produce_blocks();
+
+        option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("1400.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option2], asset::from_string("0.00 GOO"));
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( indexed_voting, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2"), option3 = name("option3");
+        name manager = name("manager");
+        name voter1 = testa, voter2 = testb;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+
+        reg_voter(voter1, treasury_symbol, {});
+        reg_voter(voter2, treasury_symbol, {});
+
+        mint(manager, voter1, asset::from_string("1000.00 GOO"), "init amount");
+        mint(manager, voter2, asset::from_string("300.00 GOO"), "init amount");
+
+        //options are indexed in name order regardless of creation order
+        new_ballot(ballot_name, category, voter1, treasury_symbol, voting_method, { option3, option1, option2 });
+        edit_min_max(voter1, ballot_name, 1, 3);
+        open_voting(voter1, ballot_name, get_current_time_point_sec() + 86400);
+        produce_blocks();
+
+        BOOST_REQUIRE_EXCEPTION(cast_vote_idx(voter1, ballot_name, { 3 }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "option index out of range" ) 
+        );
+        BOOST_REQUIRE_EXCEPTION(cast_vote_idx(voter1, ballot_name, { 0, 0 }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "option index selected more than once" ) 
+        );
+
+        cast_vote_idx(voter1, ballot_name, { 0, 2 });
+        cast_vote(voter2, ballot_name, { option2 });
+        produce_blocks();
+
+        map<name, asset> option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("1000.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option2], asset::from_string("300.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option3], asset::from_string("1000.00 GOO"));
+
+        //revote by index rolls back previous selections
+        cast_vote_idx(voter1, ballot_name, { 1 });
+        produce_blocks();
+
+        option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("0.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option2], asset::from_string("1300.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option3], asset::from_string("0.00 GOO"));
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( delegate_voting, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name delegate_name = testa, voter1 = testb, voter2 = testc;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(delegate_name, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        toggle(manager, treasury_symbol, name("stakeable"));
+        toggle(manager, treasury_symbol, name("unstakeable"));
+        toggle(manager, treasury_symbol, name("transferable"));
+
+        reg_voter(delegate_name, treasury_symbol, {});
+        reg_voter(voter1, treasury_symbol, {});
+        reg_voter(voter2, treasury_symbol, {});
+
+        mint(manager, delegate_name, asset::from_string("100.00 GOO"), "init amount");
+        mint(manager, voter1, asset::from_string("400.00 GOO"), "init amount");
+        mint(manager, voter2, asset::from_string("300.00 GOO"), "init amount");
+        stake(delegate_name, asset::from_string("100.00 GOO"));
+        stake(voter1, asset::from_string("400.00 GOO"));
+        stake(voter2, asset::from_string("300.00 GOO"));
+
+        //register delegate and delegate voter1 stake
+        reg_delegate(delegate_name, treasury_symbol);
+        delegate(voter1, delegate_name, treasury_symbol, {});
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["delegates"].as<uint32_t>(), 1);
+        BOOST_REQUIRE_EQUAL(get_voter(voter1, treasury_symbol)["delegated_to"].as<name>(), delegate_name);
+
+        fc::variant del_info = get_delegate(treasury_symbol, delegate_name);
+        BOOST_REQUIRE_EQUAL(del_info["total_delegated"].as<asset>(), asset::from_string("400.00 GOO"));
+        BOOST_REQUIRE_EQUAL(del_info["constituents"].as<uint32_t>(), 1);
+
+        BOOST_REQUIRE_EXCEPTION(delegate(delegate_name, voter1, treasury_symbol, {}), 
+            eosio_assert_message_exception, eosio_assert_message_is( "delegate not found" ) 
+        );
+        BOOST_REQUIRE_EXCEPTION(unreg_delegate(delegate_name, treasury_symbol), 
+            eosio_assert_message_exception, eosio_assert_message_is( "delegate still has constituents" ) 
+        );
+
+        //delegate ballot
+        new_ballot(ballot_name, category, delegate_name, treasury_symbol, voting_method, { option1, option2 });
+        toggle_bal(delegate_name, ballot_name, name("allowdgate"));
+        toggle_bal(delegate_name, ballot_name, name("votestake"));
+
+        BOOST_REQUIRE_EXCEPTION(open_voting(delegate_name, ballot_name, get_current_time_point_sec() + 86400), 
+            eosio_assert_message_exception, eosio_assert_message_is( "delegate ballot must vote with stake" ) 
+        );
+
+        toggle_bal(delegate_name, ballot_name, name("votestake"));
+        open_voting(delegate_name, ballot_name, get_current_time_point_sec() + 86400);
+        produce_blocks();
+
+        BOOST_REQUIRE_EXCEPTION(cast_vote(voter1, ballot_name, { option2 }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "delegated voters cannot vote on delegate ballots" ) 
+        );
+
+        //delegate votes with own stake plus delegated stake
+        cast_vote(delegate_name, ballot_name, { option1 });
+        produce_blocks();
+
+        fc::variant ballot_info = get_ballot(ballot_name);
+        map<name, asset> option_map = variant_to_map<name, asset>(ballot_info["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("500.00 GOO"));
+        BOOST_REQUIRE_EQUAL(ballot_info["total_delegates"].as<uint32_t>(), 1);
+        BOOST_REQUIRE(get_receipt(ballot_name, delegate_name)["is_delegate"].as<bool>());
+
+        //voter2 votes directly before delegating
+        cast_vote(voter2, ballot_name, { option2 });
+        produce_blocks();
+
+        option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option2], asset::from_string("300.00 GOO"));
+
+        //delegating moves voter2's stake to delegate's vote on listed ballots
+        delegate(voter2, delegate_name, treasury_symbol, { ballot_name });
+        produce_blocks();
+
+        option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("800.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option2], asset::from_string("0.00 GOO"));
+        BOOST_REQUIRE_EQUAL(get_receipt(ballot_name, voter2)["raw_votes"].as<int64_t>(), 0);
+
+        //constituent unstake adjusts delegate total
+        unstake(voter1, asset::from_string("100.00 GOO"));
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_voter(voter1, treasury_symbol)["delegated"].as<asset>(), asset::from_string("300.00 GOO"));
+        BOOST_REQUIRE_EQUAL(get_delegate(treasury_symbol, delegate_name)["total_delegated"].as<asset>(), asset::from_string("600.00 GOO"));
+
+        //one rebalance updates weight of all constituents
+        rebalance(delegate_name, delegate_name, ballot_name, {});
+        produce_blocks();
+
+        option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("700.00 GOO"));
+
+        //undelegate returns stake to voter's own vote on listed ballots
+        undelegate(voter2, treasury_symbol, { ballot_name });
+        produce_blocks();
+
+        del_info = get_delegate(treasury_symbol, delegate_name);
+        BOOST_REQUIRE_EQUAL(del_info["total_delegated"].as<asset>(), asset::from_string("300.00 GOO"));
+        BOOST_REQUIRE_EQUAL(del_info["constituents"].as<uint32_t>(), 1);
+        BOOST_REQUIRE_EQUAL(get_voter(voter2, treasury_symbol)["delegated_to"].as<name>(), name(0));
+
+        option_map = variant_to_map<name, asset>(get_ballot(ballot_name)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("400.00 GOO"));
+        BOOST_REQUIRE_EQUAL(option_map[option2], asset::from_string("300.00 GOO"));
+
+        //unregistering delegate voter removes delegate
+        undelegate(voter1, treasury_symbol, {});
+        unstake(delegate_name, asset::from_string("100.00 GOO"));
+        transfer(delegate_name, voter1, asset::from_string("100.00 GOO"), "empty delegate");
+        unreg_voter(delegate_name, treasury_symbol);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_delegate(treasury_symbol, delegate_name).is_null());
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["delegates"].as<uint32_t>(), 0);
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( tick_maintenance, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot1 = name("ballot1"), ballot2 = name("ballot2");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name voter1 = testa, cranker = testb;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(voter1, treasury_symbol, {});
+        mint(manager, voter1, asset::from_string("1000.00 GOO"), "init amount");
+
+        //ballot2 ends one day after ballot1
+        new_ballot(ballot1, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+        new_ballot(ballot2, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+        open_voting(voter1, ballot1, get_current_time_point_sec() + 86400);
+        open_voting(voter1, ballot2, get_current_time_point_sec() + 172800);
+        cast_vote(voter1, ballot1, { option1 });
+        produce_blocks();
+
+        BOOST_REQUIRE_EXCEPTION(tick(cranker, 0), 
+            eosio_assert_message_exception, eosio_assert_message_is( "max work must be greater than zero" ) 
+        );
+
+        //ballot1 ended but is still in close grace period
+        produce_block(fc::hours(25));
+        produce_blocks();
+
+        tick(cranker, 10);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot1)["status"].as<name>(), name("voting"));
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["open_ballots"].as<uint32_t>(), uint32_t(2));
+
+        //ballot1 past grace period, ballot2 still in grace period
+        produce_block(fc::days(1));
+        produce_blocks();
+
+        tick(cranker, 10);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot1)["status"].as<name>(), name("closed"));
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot2)["status"].as<name>(), name("voting"));
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["open_ballots"].as<uint32_t>(), uint32_t(1));
+
+        //results are kept when closed by tick
+        map<name, asset> option_map = variant_to_map<name, asset>(get_ballot(ballot1)["options"]);
+        BOOST_REQUIRE_EQUAL(option_map[option1], asset::from_string("1000.00 GOO"));
+
+        //cursor resumes after ballot1
+        produce_block(fc::days(1));
+        produce_blocks();
+
+        tick(cranker, 1);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot2)["status"].as<name>(), name("closed"));
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["open_ballots"].as<uint32_t>(), uint32_t(0));
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( ballot_results, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2"), option3 = name("option3");
+        name manager = name("manager");
+        name voter1 = testa, voter2 = testb, voter3 = testc;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+
+        reg_voter(voter1, treasury_symbol, {});
+        reg_voter(voter2, treasury_symbol, {});
+        reg_voter(voter3, treasury_symbol, {});
+
+        //voter3 doesn't vote, turnout is half of supply
+        mint(manager, voter1, asset::from_string("1000.00 GOO"), "init amount");
+        mint(manager, voter2, asset::from_string("300.00 GOO"), "init amount");
+        mint(manager, voter3, asset::from_string("1300.00 GOO"), "init amount");
+
+        new_ballot(ballot_name, category, voter1, treasury_symbol, voting_method, { option1, option2, option3 });
+        edit_min_max(voter1, ballot_name, 1, 3);
+        open_voting(voter1, ballot_name, get_current_time_point_sec() + 86400);
+
+        cast_vote(voter1, ballot_name, { option1, option2 });
+        cast_vote(voter2, ballot_name, { option2 });
+        produce_blocks();
+
+        BOOST_REQUIRE(get_result(ballot_name).is_null());
+
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        close_ballot(voter1, ballot_name, false);
+        produce_blocks();
+
+        //results are ranked by votes
+        fc::variant res = get_result(ballot_name);
+        vector<fc::variant> ranked = res["ranked_options"].get_array();
+        BOOST_REQUIRE_EQUAL(ranked.size(), 3);
+        BOOST_REQUIRE_EQUAL(ranked[0]["option_name"].as<name>(), option2);
+        BOOST_REQUIRE_EQUAL(ranked[0]["votes"].as<asset>(), asset::from_string("1300.00 GOO"));
+        BOOST_REQUIRE_EQUAL(ranked[0]["bps"].as<uint16_t>(), 5652);
+        BOOST_REQUIRE_EQUAL(ranked[1]["option_name"].as<name>(), option1);
+        BOOST_REQUIRE_EQUAL(ranked[1]["bps"].as<uint16_t>(), 4347);
+        BOOST_REQUIRE_EQUAL(ranked[2]["option_name"].as<name>(), option3);
+        BOOST_REQUIRE_EQUAL(ranked[2]["bps"].as<uint16_t>(), 0);
+
+        vector<name> winners = res["winners"].as<vector<name>>();
+        BOOST_REQUIRE_EQUAL(winners.size(), 1);
+        BOOST_REQUIRE_EQUAL(winners[0], option2);
+
+        BOOST_REQUIRE_EQUAL(res["total_raw_weight"].as<asset>(), asset::from_string("1300.00 GOO"));
+        BOOST_REQUIRE_EQUAL(res["total_voters"].as<uint32_t>(), 2);
+        BOOST_REQUIRE_EQUAL(res["turnout_bps"].as<uint16_t>(), 5000);
+
+        //results are erased with ballot
+        cleanup_vote(voter1, voter1, ballot_name, {});
+        cleanup_vote(voter1, voter2, ballot_name, {});
+        produce_blocks();
+        produce_block(fc::days(2));
+        produce_blocks();
+
+        delete_ballot(voter1, ballot_name);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_result(ballot_name).is_null());
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( archive_digest, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot1 = name("ballot1"), ballot2 = name("ballot2");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name voter1 = testa, voter2 = testb;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+
+        reg_voter(voter1, treasury_symbol, {});
+        reg_voter(voter2, treasury_symbol, {});
+        mint(manager, voter1, asset::from_string("1000.00 GOO"), "init amount");
+        mint(manager, voter2, asset::from_string("300.00 GOO"), "init amount");
+
+        new_ballot(ballot1, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+        new_ballot(ballot2, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+        edit_details(voter1, ballot1, "Ballot 1", "description", "content");
+        open_voting(voter1, ballot1, get_current_time_point_sec() + 86400);
+        open_voting(voter1, ballot2, get_current_time_point_sec() + 86400);
+
+        cast_vote(voter1, ballot1, { option1 });
+        cast_vote(voter2, ballot1, { option2 });
+        produce_blocks();
+
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        close_ballot(voter1, ballot1, false);
+        close_ballot(voter1, ballot2, false);
+        produce_blocks();
+
+        //regular archive charges archival fee
+        archive(voter1, ballot2, get_current_time_point_sec() + 3600);
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot2)["status"].as<name>(), name("archived"));
+
+        BOOST_REQUIRE_EXCEPTION(arch_digest(voter1, ballot1, get_current_time_point_sec() + 86400), 
+            eosio_assert_message_exception, eosio_assert_message_is( "must clean all ballot votes before compacting" ) 
+        );
+
+        cleanup_vote(voter1, voter1, ballot1, {});
+        cleanup_vote(voter1, voter2, ballot1, {});
+        produce_blocks();
+
+        //compact ballot1 to a digest
+        arch_digest(voter1, ballot1, get_current_time_point_sec() + 86400);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_ballot(ballot1).is_null());
+        BOOST_REQUIRE(!get_archival(ballot1).is_null());
+
+        fc::sha256::encoder enc;
+        fc::raw::pack(enc, string("Ballot 1"));
+        fc::raw::pack(enc, string("description"));
+        fc::raw::pack(enc, string("content"));
+
+        fc::variant dig = get_digest(ballot1);
+        BOOST_REQUIRE_EQUAL(dig["publisher"].as<name>(), voter1);
+        BOOST_REQUIRE_EQUAL(dig["metadata_hash"].as<fc::sha256>(), enc.result());
+
+        //final results are kept with digest
+        fc::variant res = get_result(ballot1);
+        BOOST_REQUIRE_EQUAL(res["winners"].as<vector<name>>()[0], option1);
+
+        BOOST_REQUIRE_EXCEPTION(new_ballot(ballot1, category, voter1, treasury_symbol, voting_method, { option1, option2 }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "ballot name reserved by archived digest" ) 
+        );
+
+        //tick releases both archivals after they expire
+        produce_block(fc::days(2));
+        produce_blocks();
+
+        tick(voter2, 10);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot2)["status"].as<name>(), name("closed"));
+        BOOST_REQUIRE(get_archival(ballot1).is_null());
+        BOOST_REQUIRE(get_digest(ballot1).is_null());
+        BOOST_REQUIRE(get_result(ballot1).is_null());
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( ballot_indexes, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name voter1 = testa;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(voter1, treasury_symbol, {});
+
+        //new ballots are indexed on creation
+        new_ballot(ballot_name, category, voter1, treasury_symbol, voting_method, { option1, option2 });
+        produce_blocks();
+
+        fc::variant idx = get_ballot_index(ballot_name);
+        BOOST_REQUIRE_EQUAL(idx["treasury_symbol"].as<symbol>(), treasury_symbol);
+        BOOST_REQUIRE_EQUAL(idx["status"].as<name>(), name("setup"));
+        BOOST_REQUIRE_EQUAL(idx["publisher"].as<name>(), voter1);
+
+        //index follows status and times
+        time_point_sec end_time = get_current_time_point_sec() + 86400;
+        open_voting(voter1, ballot_name, end_time);
+        produce_blocks();
+
+        idx = get_ballot_index(ballot_name);
+        BOOST_REQUIRE_EQUAL(idx["status"].as<name>(), name("voting"));
+        BOOST_REQUIRE_EQUAL(idx["end_time"].as<time_point_sec>(), end_time);
+
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        close_ballot(voter1, ballot_name, false);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot_index(ballot_name)["status"].as<name>(), name("closed"));
+
+        //backfill skips ballots already indexed
+        index_ballots(voter1, 10);
+        produce_blocks();
+
+        BOOST_REQUIRE_EXCEPTION(index_ballots(voter1, 10), 
+            eosio_assert_message_exception, eosio_assert_message_is( "no ballots left to index" ) 
+        );
+
+        //index is erased with ballot
+        produce_block(fc::days(2));
+        produce_blocks();
+
+        delete_ballot(voter1, ballot_name);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_ballot_index(ballot_name).is_null());
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( ballot_templates, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot1 = name("ballot1"), ballot2 = name("ballot2"), ballot3 = name("ballot3"), ballot4 = name("ballot4");
+        name template_name = name("monthly");
+        name option1 = name("option1"), option2 = name("option2"), option3 = name("option3");
+        name manager = name("manager");
+        name publisher = testa;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(publisher, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(publisher, treasury_symbol, {});
+
+        mvo spec = mvo()
+            ("category", name("proposal"))
+            ("treasury_symbol", treasury_symbol)
+            ("voting_method", name("1tokennvote"))
+            ("title", "Monthly Proposal")
+            ("description", "description")
+            ("content", "content")
+            ("min_options", 1)
+            ("max_options", 2)
+            ("options", vector<name>{ option1, option2, option3 })
+            ("settings", vector<mvo>{ mvo()("key", name("revotable"))("value", false) })
+            ("winners", 1);
+
+        //create and open in one action
+        time_point_sec end_time = get_current_time_point_sec() + 86400;
+        new_ballot_full(ballot1, publisher, spec, end_time);
+        produce_blocks();
+
+        fc::variant ballot_info = get_ballot(ballot1);
+        BOOST_REQUIRE_EQUAL(ballot_info["status"].as<name>(), name("voting"));
+        BOOST_REQUIRE_EQUAL(ballot_info["title"].as<string>(), "Monthly Proposal");
+        BOOST_REQUIRE_EQUAL(ballot_info["max_options"].as<uint8_t>(), 2);
+        BOOST_REQUIRE_EQUAL(ballot_info["end_time"].as<time_point_sec>(), end_time);
+        BOOST_REQUIRE_EQUAL(ballot_info["options"].get_array().size(), 3);
+
+        map<name, bool> settings_map = variant_to_map<name, bool>(ballot_info["settings"]);
+        BOOST_REQUIRE_EQUAL(settings_map[name("revotable")], false);
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["open_ballots"].as<uint32_t>(), uint32_t(1));
+        BOOST_REQUIRE_EQUAL(get_ballot_index(ballot1)["status"].as<name>(), name("voting"));
+
+        //unknown settings are rejected
+        mvo bad_spec = spec;
+        bad_spec("settings", vector<mvo>{ mvo()("key", name("merklevote"))("value", true) });
+        BOOST_REQUIRE_EXCEPTION(new_ballot_full(ballot2, publisher, bad_spec, end_time), 
+            eosio_assert_message_exception, eosio_assert_message_is( "setting not found" ) 
+        );
+
+        //winners are validated same as setwinners
+        bad_spec = spec;
+        bad_spec("winners", 2);
+        BOOST_REQUIRE_EXCEPTION(new_ballot_full(ballot2, publisher, bad_spec, end_time), 
+            eosio_assert_message_exception, eosio_assert_message_is( "only election ballots can have multiple winners" ) 
+        );
+        BOOST_REQUIRE_EXCEPTION(set_template(publisher, template_name, bad_spec), 
+            eosio_assert_message_exception, eosio_assert_message_is( "only election ballots can have multiple winners" ) 
+        );
+
+        mvo election_spec = spec;
+        election_spec("category", name("election"));
+        election_spec("winners", 0);
+        BOOST_REQUIRE_EXCEPTION(new_ballot_full(ballot4, publisher, election_spec, end_time), 
+            eosio_assert_message_exception, eosio_assert_message_is( "winners must be greater than zero" ) 
+        );
+
+        election_spec("winners", 2);
+        new_ballot_full(ballot4, publisher, election_spec, end_time);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot4)["winners"].as<uint8_t>(), 2);
+
+        //create and open from template
+        set_template(publisher, template_name, spec);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_template(publisher, template_name)["spec"]["title"].as<string>(), "Monthly Proposal");
+
+        new_from_tmpl(ballot2, publisher, template_name, end_time);
+        produce_blocks();
+
+        ballot_info = get_ballot(ballot2);
+        BOOST_REQUIRE_EQUAL(ballot_info["status"].as<name>(), name("voting"));
+        BOOST_REQUIRE_EQUAL(ballot_info["description"].as<string>(), "description");
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["open_ballots"].as<uint32_t>(), uint32_t(3));
+
+        //deleted templates can't be used
+        del_template(publisher, template_name);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_template(publisher, template_name).is_null());
+        BOOST_REQUIRE_EXCEPTION(new_from_tmpl(ballot3, publisher, template_name, end_time), 
+            eosio_assert_message_exception, eosio_assert_message_is( "template not found" ) 
+        );
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( shared_metadata, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot1 = name("ballot1"), ballot2 = name("ballot2");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name publisher = testa, publisher2 = testb;
+        name ballot3 = name("ballot3");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(publisher, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(publisher2, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(publisher, treasury_symbol, {});
+
+        new_ballot(ballot1, category, publisher, treasury_symbol, voting_method, { option1, option2 });
+        new_ballot(ballot2, category, publisher, treasury_symbol, voting_method, { option1, option2 });
+        new_ballot(ballot3, category, publisher2, treasury_symbol, voting_method, { option1, option2 });
+
+        //large descriptions are shared, short content stays inline
+        string boilerplate(300, 'x');
+        fc::sha256 boilerplate_hash = fc::sha256::hash(boilerplate);
+
+        edit_details(publisher, ballot1, "Ballot 1", boilerplate, "content 1");
+        edit_details(publisher, ballot2, "Ballot 2", boilerplate, "content 2");
+        produce_blocks();
+
+        fc::variant ballot_info = get_ballot(ballot1);
+        BOOST_REQUIRE_EQUAL(ballot_info["description"].as<string>(), "");
+        BOOST_REQUIRE_EQUAL(ballot_info["content"].as<string>(), "content 1");
+
+        fc::variant ref = get_metaref(ballot1);
+        BOOST_REQUIRE_EQUAL(ref["description_hash"].as<fc::sha256>(), boilerplate_hash);
+        BOOST_REQUIRE_EQUAL(ref["content_hash"].as<fc::sha256>(), fc::sha256());
+
+        fc::variant blob_info = get_blob(publisher, boilerplate_hash);
+        BOOST_REQUIRE_EQUAL(blob_info["data"].as<string>(), boilerplate);
+        BOOST_REQUIRE_EQUAL(blob_info["refs"].as<uint32_t>(), 2);
+
+        //other publishers pay for their own copy
+        edit_details(publisher2, ballot3, "Ballot 3", boilerplate, "content 3");
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_metaref(ballot3)["publisher"].as<name>(), publisher2);
+        BOOST_REQUIRE_EQUAL(get_blob(publisher2, boilerplate_hash)["refs"].as<uint32_t>(), 1);
+        BOOST_REQUIRE_EQUAL(get_blob(publisher, boilerplate_hash)["refs"].as<uint32_t>(), 2);
+
+        //editing to inline details releases reference
+        edit_details(publisher, ballot1, "Ballot 1", "short description", "content 1");
+        produce_blocks();
+
+        BOOST_REQUIRE(get_metaref(ballot1).is_null());
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot1)["description"].as<string>(), "short description");
+        BOOST_REQUIRE_EQUAL(get_blob(publisher, boilerplate_hash)["refs"].as<uint32_t>(), 1);
+
+        //deleting last referencing ballot erases blob
+        delete_ballot(publisher, ballot2);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_metaref(ballot2).is_null());
+        BOOST_REQUIRE(get_blob(publisher, boilerplate_hash).is_null());
+        BOOST_REQUIRE_EQUAL(get_blob(publisher2, boilerplate_hash)["refs"].as<uint32_t>(), 1);
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( compressed_details, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name publisher = testa;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(publisher, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(publisher, treasury_symbol, {});
+
+        new_ballot(ballot_name, category, publisher, treasury_symbol, voting_method, { option1, option2 });
+
+        //lz4 block of 20 'a' bytes with detail header
+        vector<char> packed = { 'D', 'Z', 1, 20, 0, 0, 0, 0x1a, 'a', 0x01, 0x00, 0x50, 'a', 'a', 'a', 'a', 'a' };
+
+        vector<char> bad_codec = packed;
+        bad_codec[2] = 9;
+        BOOST_REQUIRE_EXCEPTION(edit_details_z(publisher, ballot_name, "Ballot 1", bad_codec, {}), 
+            eosio_assert_message_exception, eosio_assert_message_is( "unsupported detail codec" ) 
+        );
+
+        vector<char> bad_size = packed;
+        bad_size[3] = 10;
+        BOOST_REQUIRE_EXCEPTION(edit_details_z(publisher, ballot_name, "Ballot 1", bad_size, {}), 
+            eosio_assert_message_exception, eosio_assert_message_is( "compressed detail must be smaller than original" ) 
+        );
+
+        //compressed bytes are stored as submitted
+        edit_details_z(publisher, ballot_name, "Ballot 1", packed, {});
+        produce_blocks();
+
+        fc::variant zd = get_zdetails(ballot_name);
+        BOOST_REQUIRE(zd["description"].as<vector<char>>() == packed);
+        BOOST_REQUIRE(zd["content"].as<vector<char>>().empty());
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["title"].as<string>(), "Ballot 1");
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["description"].as<string>(), "");
+
+        //partial edit leaves unsent details unchanged
+        edit_details(publisher, ballot_name, "Ballot 1", "description", "plain content");
+        edit_details_z(publisher, ballot_name, "Ballot 1", packed, {});
+        produce_blocks();
+
+        zd = get_zdetails(ballot_name);
+        BOOST_REQUIRE(zd["description"].as<vector<char>>() == packed);
+        BOOST_REQUIRE(zd["content"].as<vector<char>>().empty());
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["description"].as<string>(), "");
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["content"].as<string>(), "plain content");
+
+        edit_details_z(publisher, ballot_name, "Ballot 1 edited", {}, packed);
+        produce_blocks();
+
+        zd = get_zdetails(ballot_name);
+        BOOST_REQUIRE(zd["description"].as<vector<char>>() == packed);
+        BOOST_REQUIRE(zd["content"].as<vector<char>>() == packed);
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["title"].as<string>(), "Ballot 1 edited");
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["content"].as<string>(), "");
+
+        //plain details replace compressed details
+        edit_details(publisher, ballot_name, "Ballot 1", "description", "content");
+        produce_blocks();
+
+        BOOST_REQUIRE(get_zdetails(ballot_name).is_null());
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["description"].as<string>(), "description");
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( broadcast_subscribers, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name category = name("proposal");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2");
+        name manager = name("manager");
+        name publisher = testa, listener1 = testb, listener2 = testc;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(publisher, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(publisher, treasury_symbol, {});
+
+        new_ballot(ballot_name, category, publisher, treasury_symbol, voting_method, { option1, option2 });
+        open_voting(publisher, ballot_name, get_current_time_point_sec() + 86400);
+
+        //listeners subscribe to ballot
+        subscribe(listener1, ballot_name);
+        subscribe(listener2, ballot_name);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_subscriber(ballot_name, listener1)["listener"].as<name>(), listener1);
+        BOOST_REQUIRE_EXCEPTION(subscribe(listener1, ballot_name), 
+            eosio_assert_message_exception, eosio_assert_message_is( "listener already subscribed" ) 
+        );
+
+        //unsubscribed listeners aren't notified
+        unsubscribe(listener2, ballot_name);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_subscriber(ballot_name, listener2).is_null());
+
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        //broadcast notifies publisher and each subscriber
+        auto trace = close_ballot(publisher, ballot_name, true);
+        produce_blocks();
+
+        auto notified = [&](name receiver) {
+            return std::find_if(trace->action_traces.begin(), trace->action_traces.end(), [&](const action_trace& a_trace) {
+                return a_trace.act.name == name("broadcast") && a_trace.receiver == receiver;
+            }) != trace->action_traces.end();
+        };
+
+        BOOST_REQUIRE(notified(publisher));
+        BOOST_REQUIRE(notified(listener1));
+        BOOST_REQUIRE(!notified(listener2));
+
+        BOOST_REQUIRE_EXCEPTION(subscribe(listener2, ballot_name), 
+            eosio_assert_message_exception, eosio_assert_message_is( "ballot must be in setup or voting mode to subscribe" ) 
+        );
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( hostile_subscriber, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1");
+        name manager = name("manager");
+        name publisher = testa, listener = testb, hostile = name("hostile");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        create_account_with_resources(hostile, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(publisher, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        //hostile listener asserts on every notification
+        set_code(hostile, R"=====(
+(module
+ (import "env" "eosio_assert" (func $eosio_assert (param i32 i32)))
+ (memory $0 1)
+ (export "memory" (memory $0))
+ (export "apply" (func $apply))
+ (data (i32.const 8) "hostile listener\00")
+ (func $apply (param $0 i64) (param $1 i64) (param $2 i64)
+  (call $eosio_assert (i32.const 0) (i32.const 8))
+ )
+)
+)=====");
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(publisher, treasury_symbol, {});
+
+        new_ballot(ballot_name, name("proposal"), publisher, treasury_symbol, name("1tokennvote"), { name("option1"), name("option2") });
+        open_voting(publisher, ballot_name, get_current_time_point_sec() + 86400);
+
+        subscribe(listener, ballot_name);
+        subscribe(hostile, ballot_name);
+        produce_blocks();
+
+        //other accounts can't remove listeners
+        BOOST_REQUIRE_EXCEPTION(unsubscribe(testc, hostile, ballot_name), 
+            eosio_assert_message_exception, eosio_assert_message_is( "missing authority of listener or ballot publisher" ) 
+        );
+
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        //hostile listener blocks broadcast
+        BOOST_REQUIRE_EXCEPTION(close_ballot(publisher, ballot_name, true), 
+            eosio_assert_message_exception, eosio_assert_message_is( "hostile listener" ) 
+        );
+
+        //publisher removes hostile listener, then broadcast succeeds
+        unsubscribe(publisher, hostile, ballot_name);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_subscriber(ballot_name, hostile).is_null());
+        BOOST_REQUIRE(!get_subscriber(ballot_name, listener).is_null());
+
+        close_ballot(publisher, ballot_name, true);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["status"].as<name>(), name("closed"));
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( notify_policy, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name manager = name("manager");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        toggle(manager, treasury_symbol, name("transferable"));
+        reg_voter(testa, treasury_symbol, {});
+        reg_voter(testb, treasury_symbol, {});
+        produce_blocks();
+
+        auto notified = [&](transaction_trace_ptr trace, name action_name, name receiver) {
+            return std::find_if(trace->action_traces.begin(), trace->action_traces.end(), [&](const action_trace& a_trace) {
+                return a_trace.act.name == action_name && a_trace.receiver == receiver;
+            }) != trace->action_traces.end();
+        };
+
+        //treasuries without a policy notify always
+        BOOST_REQUIRE(get_notify_policy(treasury_symbol).is_null());
+        auto trace = mint(manager, testa, asset::from_string("100.00 GOO"), "mint");
+        produce_blocks();
+        BOOST_REQUIRE(notified(trace, name("mint"), testa));
+
+        BOOST_REQUIRE_EXCEPTION(set_notify(manager, treasury_symbol, name("sometimes")), 
+            eosio_assert_message_exception, eosio_assert_message_is( "invalid notify policy" ) 
+        );
+
+        //never policy skips notifications
+        set_notify(manager, treasury_symbol, name("never"));
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_notify_policy(treasury_symbol)["policy"].as<name>(), name("never"));
+        trace = transfer(testa, testb, asset::from_string("10.00 GOO"), "never");
+        produce_blocks();
+        BOOST_REQUIRE(!notified(trace, name("transfer"), testa));
+        BOOST_REQUIRE(!notified(trace, name("transfer"), testb));
+
+        //optin policy notifies opted in accounts only
+        set_notify(manager, treasury_symbol, name("optin"));
+        opt_in_notify(testb, treasury_symbol);
+        produce_blocks();
+
+        BOOST_REQUIRE(!get_notify_optin(testb, treasury_symbol).is_null());
+        BOOST_REQUIRE_EXCEPTION(opt_in_notify(testb, treasury_symbol), 
+            eosio_assert_message_exception, eosio_assert_message_is( "account already opted in" ) 
+        );
+
+        trace = transfer(testa, testb, asset::from_string("10.00 GOO"), "optin");
+        produce_blocks();
+        BOOST_REQUIRE(!notified(trace, name("transfer"), testa));
+        BOOST_REQUIRE(notified(trace, name("transfer"), testb));
+
+        opt_out_notify(testb, treasury_symbol);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_notify_optin(testb, treasury_symbol).is_null());
+        trace = transfer(testa, testb, asset::from_string("10.00 GOO"), "opted out");
+        produce_blocks();
+        BOOST_REQUIRE(!notified(trace, name("transfer"), testb));
+
+        //always policy erases row
+        set_notify(manager, treasury_symbol, name("always"));
+        produce_blocks();
+
+        BOOST_REQUIRE(get_notify_policy(treasury_symbol).is_null());
+        trace = transfer(testa, testb, asset::from_string("10.00 GOO"), "always");
+        produce_blocks();
+        BOOST_REQUIRE(notified(trace, name("transfer"), testa));
+        BOOST_REQUIRE(notified(trace, name("transfer"), testb));
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( batch_seats, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name manager = name("manager");
+        name committee_name = name("tf");
+        name seat1 = name("seat1"), seat2 = name("seat2"), seat3 = name("seat3");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(testa, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(testa, treasury_symbol, {});
+
+        reg_committee(committee_name, "Telos Foundation", treasury_symbol, { seat1, seat2, seat3 }, testa);
+        produce_blocks();
+
+        //assign all seats at once
+        assign_seats(testa, committee_name, treasury_symbol, { { seat1, testa }, { seat2, testb }, { seat3, testc } }, "election");
+        produce_blocks();
+
+        map<name, name> seat_map = variant_to_map<name, name>(get_committee(treasury_symbol, committee_name)["seats"]);
+        BOOST_REQUIRE_EQUAL(seat_map[seat1], testa);
+        BOOST_REQUIRE_EQUAL(seat_map[seat2], testb);
+        BOOST_REQUIRE_EQUAL(seat_map[seat3], testc);
+
+        BOOST_REQUIRE_EXCEPTION(assign_seats(testa, committee_name, treasury_symbol, { { seat1, testb }, { name("seat4"), testc } }, "bad seat"), 
+            eosio_assert_message_exception, eosio_assert_message_is( "seat name not found" ) 
+        );
+        BOOST_REQUIRE_EXCEPTION(assign_seats(testa, committee_name, treasury_symbol, { { seat1, testb }, { seat1, testc } }, "duplicate seat"), 
+            eosio_assert_message_exception, eosio_assert_message_is( "seat assigned more than once" ) 
+        );
+
+        //vacate two seats at once
+        vacate_seats(testa, committee_name, treasury_symbol, { seat1, seat3 }, "recall");
+        produce_blocks();
+
+        seat_map = variant_to_map<name, name>(get_committee(treasury_symbol, committee_name)["seats"]);
+        BOOST_REQUIRE_EQUAL(seat_map[seat1], name(0));
+        BOOST_REQUIRE_EQUAL(seat_map[seat2], testb);
+        BOOST_REQUIRE_EQUAL(seat_map[seat3], name(0));
+
+        BOOST_REQUIRE_EXCEPTION(vacate_seats(testa, committee_name, treasury_symbol, {}, "nothing"), 
+            eosio_assert_message_exception, eosio_assert_message_is( "must vacate at least one seat" ) 
+        );
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( held_seats, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name manager = name("manager");
+        name committee1 = name("tf"), committee2 = name("council");
+        name seat1 = name("seat1"), seat2 = name("seat2");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(testa, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(testb, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        reg_voter(testa, treasury_symbol, {});
+        reg_voter(testb, treasury_symbol, {});
+
+        //committees have different updaters
+        reg_committee(committee1, "Telos Foundation", treasury_symbol, { seat1, seat2 }, testa);
+        reg_committee(committee2, "Council", treasury_symbol, { seat1 }, testb);
+        produce_blocks();
+
+        auto held = [&](name holder) {
+            vector<pair<name, name>> seats;
+            fc::variant hs = get_held_seats(holder, treasury_symbol);
+            if (!hs.is_null()) {
+                for (auto& s : hs["seats"].get_array()) {
+                    seats.push_back({ s["first"].as<name>(), s["second"].as<name>() });
+                }
+            }
+            return seats;
+        };
+
+        //assignments add held seats, second updater pays for growing row
+        assign_seat(testa, committee1, treasury_symbol, seat1, testb, "election");
+        assign_seats(testb, committee2, treasury_symbol, { { seat1, testb } }, "election");
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(held(testb).size(), 2);
+        BOOST_REQUIRE(held(testb)[0] == make_pair(committee1, seat1));
+        BOOST_REQUIRE(held(testb)[1] == make_pair(committee2, seat1));
+
+        //reassignment moves held seat to new holder
+        assign_seat(testa, committee1, treasury_symbol, seat1, testc, "reelection");
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(held(testb).size(), 1);
+        BOOST_REQUIRE(held(testc)[0] == make_pair(committee1, seat1));
+
+        //removing seat removes held seat
+        assign_seat(testa, committee1, treasury_symbol, seat2, testc, "election");
+        remove_seat(testa, committee1, treasury_symbol, seat1);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(held(testc).size(), 1);
+        BOOST_REQUIRE(held(testc)[0] == make_pair(committee1, seat2));
+
+        //sync is idempotent
+        sync_seats(testa, committee1, treasury_symbol);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(held(testc).size(), 1);
+
+        //deleting committee erases held seats rows
+        del_committee(testa, committee1, treasury_symbol, "dissolve");
+        vacate_seats(testb, committee2, treasury_symbol, { seat1 }, "recall");
+        produce_blocks();
+
+        BOOST_REQUIRE(get_held_seats(testb, treasury_symbol).is_null());
+        BOOST_REQUIRE(get_held_seats(testc, treasury_symbol).is_null());
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( multi_winner_results, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        name ballot_name = name("ballot1"), proposal_name = name("proposal1");
+        name voting_method = name("1tokennvote");
+        name option1 = name("option1"), option2 = name("option2"), option3 = name("option3"), option4 = name("option4");
+        name manager = name("manager");
+        name voter1 = testa, voter2 = testb, voter3 = testc;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+
+        reg_voter(voter1, treasury_symbol, {});
+        reg_voter(voter2, treasury_symbol, {});
+        reg_voter(voter3, treasury_symbol, {});
+
+        mint(manager, voter1, asset::from_string("1000.00 GOO"), "init amount");
+        mint(manager, voter2, asset::from_string("300.00 GOO"), "init amount");
+        mint(manager, voter3, asset::from_string("1000.00 GOO"), "init amount");
+
+        //only election ballots can have multiple winners
+        new_ballot(proposal_name, name("proposal"), voter1, treasury_symbol, voting_method, { option1, option2 });
+        BOOST_REQUIRE_EXCEPTION(set_winners(voter1, proposal_name, 2), 
+            eosio_assert_message_exception, eosio_assert_message_is( "only election ballots can have multiple winners" ) 
+        );
+
+        new_ballot(ballot_name, name("election"), voter1, treasury_symbol, voting_method, { option1, option2, option3, option4 });
+        edit_min_max(voter1, ballot_name, 1, 2);
+        set_winners(voter1, ballot_name, 4);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_ballot(ballot_name)["winners"].as<uint8_t>(), 4);
+        BOOST_REQUIRE_EXCEPTION(open_voting(voter1, ballot_name, get_current_time_point_sec() + 86400), 
+            eosio_assert_message_exception, eosio_assert_message_is( "ballot must have more options than winners" ) 
+        );
+
+        set_winners(voter1, ballot_name, 2);
+        open_voting(voter1, ballot_name, get_current_time_point_sec() + 86400);
+
+        //option3 leads, option1 and option2 tie for the second seat
+        cast_vote(voter1, ballot_name, { option1, option3 });
+        cast_vote(voter2, ballot_name, { option3 });
+        cast_vote(voter3, ballot_name, { option2 });
+        produce_blocks();
+
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        close_ballot(voter1, ballot_name, false);
+        produce_blocks();
+
+        //top 2 winners in rank order, tie broken by option name
+        vector<name> winners = get_result(ballot_name)["winners"].as<vector<name>>();
+        BOOST_REQUIRE_EQUAL(winners.size(), 2);
+        BOOST_REQUIRE_EQUAL(winners[0], option3);
+        BOOST_REQUIRE_EQUAL(winners[1], option1);
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( watcher_seats, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        symbol other_symbol = symbol(2, "FOO");
+        name ballot_name = name("ballot1");
+        name voting_method = name("1tokennvote");
+        name committee_name = name("council");
+        name seat1 = name("seat1"), seat2 = name("seat2");
+        name manager = name("manager");
+        name voter1 = testa, voter2 = testb, voter3 = testc;
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+
+        base_tester::transfer(voter1, decide_name, "3000.0000 TLOS", "", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+
+        reg_voter(voter1, treasury_symbol, {});
+        reg_voter(voter2, treasury_symbol, {});
+        reg_voter(voter3, treasury_symbol, {});
+
+        mint(manager, voter1, asset::from_string("1000.00 GOO"), "init amount");
+        mint(manager, voter2, asset::from_string("300.00 GOO"), "init amount");
+        mint(manager, voter3, asset::from_string("1000.00 GOO"), "init amount");
+
+        //committee is updated by watcher
+        reg_committee(committee_name, "Council", treasury_symbol, { seat1, seat2 }, voter1);
+        set_updater({ { voter1, name("active") }, { watcher_name, name("active") } }, committee_name, treasury_symbol, watcher_name, name("active"));
+
+        new_ballot(ballot_name, name("election"), voter1, treasury_symbol, voting_method, { voter1, voter2, voter3 });
+        edit_min_max(voter1, ballot_name, 1, 2);
+        set_winners(voter1, ballot_name, 2);
+        produce_blocks();
+
+        //only watcher can watch ballots
+        BOOST_REQUIRE_EXCEPTION(watch_seats(voter1, ballot_name, treasury_symbol, committee_name, { seat1, seat2 }), 
+            missing_auth_exception, eosio::testing::fc_exception_message_starts_with( "missing authority" ) 
+        );
+
+        //first watch subscribes watcher to ballot broadcast
+        watch_seats(watcher_name, ballot_name, treasury_symbol, committee_name, { seat1, seat2 });
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_subscriber(ballot_name, watcher_name)["listener"].as<name>(), watcher_name);
+        BOOST_REQUIRE_EQUAL(get_seat_watch(ballot_name, 0)["committee_name"].as<name>(), committee_name);
+        BOOST_REQUIRE_EXCEPTION(watch_seats(watcher_name, ballot_name, treasury_symbol, committee_name, { seat1 }), 
+            eosio_assert_message_exception, eosio_assert_message_is( "committee is already watching ballot" ) 
+        );
+
+        //committee with same name under another treasury has its own watch
+        watch_seats(watcher_name, ballot_name, other_symbol, committee_name, { seat1 });
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_seat_watch(ballot_name, 1)["treasury_symbol"].as<symbol>(), other_symbol);
+
+        unwatch(watcher_name, ballot_name, other_symbol, committee_name);
+        produce_blocks();
+
+        BOOST_REQUIRE(get_seat_watch(ballot_name, 1).is_null());
+        BOOST_REQUIRE(!get_subscriber(ballot_name, watcher_name).is_null());
+
+        open_voting(voter1, ballot_name, get_current_time_point_sec() + 86400);
+
+        //voter3 leads, voter1 takes the second seat
+        cast_vote(voter1, ballot_name, { voter1, voter3 });
+        cast_vote(voter2, ballot_name, { voter2 });
+        cast_vote(voter3, ballot_name, { voter3 });
+        produce_blocks();
+
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        //results broadcast makes watcher assign winners inline
+        auto trace = close_ballot(voter1, ballot_name, true);
+        produce_blocks();
+
+        BOOST_REQUIRE(std::find_if(trace->action_traces.begin(), trace->action_traces.end(), [&](const action_trace& a_trace) {
+            return a_trace.act.name == name("assignseats") && a_trace.receiver == decide_name;
+        }) != trace->action_traces.end());
+
+        map<name, name> seats = variant_to_map<name, name>(get_committee(treasury_symbol, committee_name)["seats"]);
+        BOOST_REQUIRE_EQUAL(seats[seat1], voter3);
+        BOOST_REQUIRE_EQUAL(seats[seat2], voter1);
+
+        //seat watch is erased after results are handled
+        BOOST_REQUIRE(get_seat_watch(ballot_name, 0).is_null());
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( bulk_voter_registration, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        asset public_supply = asset::from_string("1000000.00 PUB");
+        name manager = name("manager");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("private"));
+        new_treasury(manager, public_supply, name("public"));
+        produce_blocks();
+
+        //only manager can register voters on private treasury
+        BOOST_REQUIRE_EXCEPTION(reg_voters(testa, { testb, testc }, treasury_symbol, testa), 
+            eosio_assert_message_exception, eosio_assert_message_is( "referrer must be treasury manager" ) 
+        );
+
+        reg_voters(manager, { testa, testb, testc }, treasury_symbol, {});
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["voters"].as<uint32_t>(), 3);
+        BOOST_REQUIRE_EQUAL(get_voter(testa, treasury_symbol)["liquid"].as<asset>(), asset::from_string("0.00 GOO"));
+        BOOST_REQUIRE_EQUAL(get_voter(testc, treasury_symbol)["staked"].as<asset>(), asset::from_string("0.00 GOO"));
+
+        BOOST_REQUIRE_EXCEPTION(reg_voters(manager, { manager, testa }, treasury_symbol, {}), 
+            eosio_assert_message_exception, eosio_assert_message_is( "voter already exists" ) 
+        );
+
+        //public treasury requires a referrer to pay for voters
+        BOOST_REQUIRE_EXCEPTION(reg_voters(testa, { testb, testc }, public_supply.get_symbol(), {}), 
+            eosio_assert_message_exception, eosio_assert_message_is( "referrer required to register voters on public treasury" ) 
+        );
+
+        reg_voters(testa, { testb, testc }, public_supply.get_symbol(), testa);
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_trs_stats(public_supply.get_symbol())["voters"].as<uint32_t>(), 2);
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( lazy_voter_creation, decide_tester ) try {
+
+        //initialize
+        asset max_supply = asset::from_string("1000000.00 GOO");
+        symbol treasury_symbol = max_supply.get_symbol();
+        asset private_supply = asset::from_string("1000000.00 PRV");
+        name manager = name("manager");
+
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        new_treasury(manager, private_supply, name("private"));
+        toggle(manager, treasury_symbol, name("transferable"));
+        toggle(manager, treasury_symbol, name("mgrpaysram"));
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(variant_to_map<name, bool>(get_treasury(treasury_symbol)["settings"])[name("mgrpaysram")], true);
+
+        //mint creates voter on first credit, paid by manager
+        auto trace = mint(manager, testa, asset::from_string("100.00 GOO"), "airdrop");
+        produce_blocks();
+
+        validate_action_payer(trace, decide_name, name("mint"), manager);
+        BOOST_REQUIRE_EQUAL(get_voter(testa, treasury_symbol)["liquid"].as<asset>(), asset::from_string("100.00 GOO"));
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["voters"].as<uint32_t>(), 1);
+
+        //manager must authorize transfers that create voters while manager pays ram
+        BOOST_REQUIRE_EXCEPTION(transfer(testa, testb, asset::from_string("10.00 GOO"), "new holder"), 
+            eosio_assert_message_exception, eosio_assert_message_is( "new voter ram payer must authorize" ) 
+        );
+
+        //sender pays when manager doesn't
+        toggle(manager, treasury_symbol, name("mgrpaysram"));
+        trace = transfer(testa, testb, asset::from_string("10.00 GOO"), "new holder");
+        produce_blocks();
+
+        validate_action_payer(trace, decide_name, name("transfer"), testa);
+        BOOST_REQUIRE_EQUAL(get_voter(testb, treasury_symbol)["liquid"].as<asset>(), asset::from_string("10.00 GOO"));
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["voters"].as<uint32_t>(), 2);
+
+        //existing voters don't change voter count
+        transfer(testa, testb, asset::from_string("10.00 GOO"), "existing holder");
+        produce_blocks();
+
+        BOOST_REQUIRE_EQUAL(get_trs_stats(treasury_symbol)["voters"].as<uint32_t>(), 2);
+
+        //private treasuries still require registration
+        BOOST_REQUIRE_EXCEPTION(mint(manager, testa, asset::from_string("100.00 PRV"), "airdrop"), 
+            eosio_assert_message_exception, eosio_assert_message_is( "add_liquid: voter not found" ) 
+        );
+
+    } FC_LOG_AND_RETHROW()
+
     
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
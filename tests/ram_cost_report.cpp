@@ -0,0 +1,290 @@
+#include <boost/test/unit_test.hpp>
+#include <eosio/testing/tester.hpp>
+#include <fc/variant_object.hpp>
+#include <eosio/chain/abi_serializer.hpp>
+#include <eosio/chain/contract_table_objects.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "decide_tester.hpp"
+
+using namespace eosio;
+using namespace eosio::testing;
+using namespace eosio::chain;
+using namespace fc;
+using namespace std;
+using namespace decidetesting::testing;
+using mvo = fc::mutable_variant_object;
+
+//prints ram cost of telos decide tables and ballot lifecycles
+//run with: unit_test --run_test=ram_cost_report
+//parameters are read from the environment:
+//  DECIDE_RAM_VOTERS   voters per ballot (default 10)
+//  DECIDE_RAM_OPTIONS  options per ballot (default 5)
+//  DECIDE_RAM_CONTENT  ballot content bytes (default 2048)
+class ram_cost_tester : public decide_tester {
+
+    public:
+
+    //rows and index entries stored under one table name
+    struct table_usage {
+        uint32_t table_ids = 0; //one per scope and secondary index
+        uint32_t rows = 0;
+        uint64_t payload_bytes = 0;
+        uint32_t idx64_entries = 0;
+        uint32_t idx128_entries = 0;
+
+        //bytes billed by the chain for this usage
+        int64_t billed_bytes() const {
+            return int64_t(table_ids * config::billable_size_v<table_id_object>
+                + rows * config::billable_size_v<key_value_object> + payload_bytes
+                + idx64_entries * config::billable_size_v<index64_object>
+                + idx128_entries * config::billable_size_v<index128_object>);
+        }
+    };
+
+    //ram charged by one lifecycle step
+    struct step_cost {
+        string step;
+        uint32_t actions = 0;
+        int64_t ram_bytes = 0;
+    };
+
+    const asset max_supply = asset::from_string("1000000000.00 RAM");
+    const symbol treasury_symbol = max_supply.get_symbol();
+    const name manager = name("manager");
+    const name publisher = testa;
+
+    const uint32_t voter_count = env_param("DECIDE_RAM_VOTERS", 10);
+    const uint32_t option_count = env_param("DECIDE_RAM_OPTIONS", 5);
+    const uint32_t content_size = env_param("DECIDE_RAM_CONTENT", 2048);
+
+    ram_cost_tester() {
+        create_account_with_resources(manager, eosio_name, asset::from_string("400.0000 TLOS"), false);
+        base_tester::transfer(eosio_name, manager, "10000.0000 TLOS", "initial funds", token_name);
+        base_tester::transfer(manager, decide_name, "5000.0000 TLOS", "", token_name);
+        base_tester::transfer(publisher, decide_name, "5000.0000 TLOS", "", token_name);
+
+        new_treasury(manager, max_supply, name("public"));
+        produce_blocks();
+    }
+
+    static uint32_t env_param(const char* var, uint32_t default_value) {
+        const char* value = getenv(var);
+        return value ? uint32_t(stoul(value)) : default_value;
+    }
+
+    //walks every table of code in chain state, grouping secondary indexes under their table name
+    map<name, table_usage> get_table_usage(name code) {
+        const auto& db = control->db();
+        const auto& tables = db.get_index<table_id_multi_index, by_code_scope_table>();
+        const auto& kv_rows = db.get_index<key_value_index, by_scope_primary>();
+        const auto& idx64 = db.get_index<index64_index, by_primary>();
+        const auto& idx128 = db.get_index<index128_index, by_primary>();
+
+        map<name, table_usage> usage;
+        for (auto t_itr = tables.lower_bound(boost::make_tuple(code, name(), name())); t_itr != tables.end() && t_itr->code == code; t_itr++) {
+            //secondary indexes store the index number in the low 4 bits of the table name
+            auto& tu = usage[name(t_itr->table.to_uint64_t() & 0xFFFFFFFFFFFFFFF0ULL)];
+            tu.table_ids += 1;
+
+            for (auto r = kv_rows.lower_bound(boost::make_tuple(t_itr->id, uint64_t(0))); r != kv_rows.end() && r->t_id == t_itr->id; r++) {
+                tu.rows += 1;
+                tu.payload_bytes += r->value.size();
+            }
+            for (auto i = idx64.lower_bound(boost::make_tuple(t_itr->id, uint64_t(0))); i != idx64.end() && i->t_id == t_itr->id; i++) {
+                tu.idx64_entries += 1;
+            }
+            for (auto i = idx128.lower_bound(boost::make_tuple(t_itr->id, uint64_t(0))); i != idx128.end() && i->t_id == t_itr->id; i++) {
+                tu.idx128_entries += 1;
+            }
+        }
+        return usage;
+    }
+
+    int64_t get_total_usage(name code) {
+        int64_t total = 0;
+        for (const auto& t : get_table_usage(code)) {
+            total += t.second.billed_bytes();
+        }
+        return total;
+    }
+
+    //returns table name -> row type for every table in the decide abi
+    vector<pair<name, string>> get_abi_tables() {
+        const auto& accnt = control->db().get<account_object,by_name>(decide_name);
+        abi_def abi;
+        BOOST_REQUIRE_EQUAL(abi_serializer::to_abi(accnt.abi, abi), true);
+
+        vector<pair<name, string>> abi_tables;
+        for (const auto& t : abi.tables) {
+            abi_tables.push_back({ t.name, t.type });
+        }
+        return abi_tables;
+    }
+
+    void add_step(vector<step_cost>& steps, string step, transaction_trace_ptr trace) {
+        if (steps.empty() || steps.back().step != step) {
+            steps.push_back(step_cost{ step });
+        }
+        steps.back().actions += 1;
+        steps.back().ram_bytes += get_resource_usage(trace).ram_bytes;
+    }
+
+    //runs a ballot from newballot to the given ending, returning ram charged at each step
+    vector<step_cost> run_lifecycle(name ballot_name, const vector<name>& voters, name ending) {
+        vector<step_cost> steps;
+        vector<name> options = make_names("opt", option_count);
+
+        add_step(steps, "newballot", new_ballot(ballot_name, name("poll"), publisher, treasury_symbol, name("1tokennvote"), options));
+        add_step(steps, "editdetails", edit_details(publisher, ballot_name, string(64, 't'), string(512, 'd'), string(content_size, 'c')));
+        add_step(steps, "openvoting", open_voting(publisher, ballot_name, get_current_time_point_sec() + 86400));
+        produce_blocks();
+
+        for (size_t i = 0; i < voters.size(); i++) {
+            add_step(steps, "castvote", cast_vote(voters[i], ballot_name, { options[i % options.size()] }));
+        }
+        produce_blocks();
+
+        produce_block(fc::seconds(86401));
+        produce_blocks();
+
+        add_step(steps, "closevoting", close_ballot(publisher, ballot_name, false));
+        for (name v : voters) {
+            add_step(steps, "cleanupvote", cleanup_vote(publisher, v, ballot_name, {}));
+        }
+        produce_blocks();
+
+        if (ending == name("delete")) {
+            produce_block(fc::days(2));
+            produce_blocks();
+            add_step(steps, "deleteballot", delete_ballot(publisher, ballot_name));
+        } else if (ending == name("archive")) {
+            add_step(steps, "archive", archive(publisher, ballot_name, get_current_time_point_sec() + 86400 * 30));
+        } else {
+            add_step(steps, "archdigest", arch_digest(publisher, ballot_name, get_current_time_point_sec() + 86400 * 30));
+        }
+        produce_blocks();
+
+        return steps;
+    }
+
+    void print_lifecycle(name ending, const vector<step_cost>& steps) {
+        int64_t peak = 0;
+        int64_t running = 0;
+        cout << endl << "ballot lifecycle ending in " << ending.to_string() << " (voters=" << voter_count
+            << " options=" << option_count << " content_bytes=" << content_size << ")" << endl;
+        cout << left << setw(14) << "step" << right << setw(10) << "actions" << setw(14) << "ram_bytes"
+            << setw(14) << "per_action" << setw(14) << "running" << endl;
+        for (const auto& s : steps) {
+            running += s.ram_bytes;
+            peak = max(peak, running);
+            cout << left << setw(14) << s.step << right << setw(10) << s.actions << setw(14) << s.ram_bytes
+                << setw(14) << s.ram_bytes / int64_t(s.actions) << setw(14) << running << endl;
+        }
+        cout << "peak ram: " << peak << " bytes, retained after " << ending.to_string() << ": " << running << " bytes" << endl;
+    }
+
+};
+
+BOOST_AUTO_TEST_SUITE(ram_cost_report)
+
+    BOOST_FIXTURE_TEST_CASE( table_row_costs, ram_cost_tester ) try {
+
+        //exercise as many tables as possible with realistic field sizes
+        vector<name> voters = make_names("rcv", voter_count);
+        create_accounts_with_resources(voters);
+        for (name v : voters) {
+            mint(manager, v, asset::from_string("100.00 RAM"), "ram report");
+        }
+        reg_voter(publisher, treasury_symbol, {});
+        edit_trs_info(manager, treasury_symbol, string(32, 't'), string(256, 'd'), string(64, 'i'));
+        set_notify(manager, treasury_symbol, name("optin"));
+        opt_in_notify(voters[0], treasury_symbol);
+        reg_delegate(voters[0], treasury_symbol);
+        delegate(voters[1], voters[0], treasury_symbol, {});
+        reg_committee(name("committee1"), string(64, 'c'), treasury_symbol, make_names("seat", 3), publisher);
+        assign_seat(publisher, name("committee1"), treasury_symbol, name("seataaaaa"), voters[2], "ram report");
+        produce_blocks();
+
+        new_ballot(name("subscribed"), name("poll"), publisher, treasury_symbol, name("1tokennvote"), make_names("opt", option_count));
+        subscribe(testb, name("subscribed"));
+        run_lifecycle(name("archived"), voters, name("archive"));
+        run_lifecycle(name("digested"), voters, name("digest"));
+
+        //leave a ballot with live votes and results
+        vector<name> options = make_names("opt", option_count);
+        new_ballot(name("voting"), name("poll"), publisher, treasury_symbol, name("1tokennvote"), options);
+        open_voting(publisher, name("voting"), get_current_time_point_sec() + 86400);
+        for (size_t i = 0; i < voters.size(); i++) {
+            cast_vote(voters[i], name("voting"), { options[i % options.size()] });
+        }
+        produce_block(fc::seconds(86401));
+        close_ballot(publisher, name("voting"), false);
+        produce_blocks();
+
+        map<name, table_usage> usage = get_table_usage(decide_name);
+
+        cout << endl << "chain ram overhead: table " << config::billable_size_v<table_id_object>
+            << " bytes, row " << config::billable_size_v<key_value_object>
+            << " bytes, idx64 entry " << config::billable_size_v<index64_object>
+            << " bytes, idx128 entry " << config::billable_size_v<index128_object> << " bytes" << endl;
+        cout << left << setw(14) << "table" << setw(18) << "row_type" << right << setw(8) << "tables" << setw(8) << "rows"
+            << setw(12) << "avg_payload" << setw(12) << "idx_bytes" << setw(14) << "bytes_per_row" << setw(14) << "total_bytes" << endl;
+
+        for (const auto& t : get_abi_tables()) {
+            cout << left << setw(14) << t.first.to_string() << setw(18) << t.second << right;
+            auto u_itr = usage.find(t.first);
+            if (u_itr == usage.end() || u_itr->second.rows == 0) {
+                cout << setw(8) << "-" << setw(8) << "-" << "  not exercised" << endl;
+                continue;
+            }
+
+            const auto& u = u_itr->second;
+            int64_t idx_bytes = int64_t(u.idx64_entries * config::billable_size_v<index64_object>
+                + u.idx128_entries * config::billable_size_v<index128_object>);
+            int64_t row_bytes = int64_t(config::billable_size_v<key_value_object> + u.payload_bytes / u.rows) + idx_bytes / int64_t(u.rows);
+
+            cout << setw(8) << u.table_ids << setw(8) << u.rows << setw(12) << u.payload_bytes / u.rows
+                << setw(12) << idx_bytes / int64_t(u.rows) << setw(14) << row_bytes << setw(14) << u.billed_bytes() << endl;
+
+            //every row pays at least the row overhead, and indexed tables pay for every index entry
+            BOOST_REQUIRE(row_bytes > int64_t(config::billable_size_v<key_value_object>));
+        }
+
+        //ballots carry 4 secondary indexes per row
+        BOOST_REQUIRE_EQUAL(usage[name("ballots")].idx64_entries, usage[name("ballots")].rows * 4);
+
+    } FC_LOG_AND_RETHROW()
+
+    BOOST_FIXTURE_TEST_CASE( ballot_lifecycle_costs, ram_cost_tester ) try {
+
+        vector<name> voters = make_names("lcv", voter_count);
+        create_accounts_with_resources(voters);
+        for (name v : voters) {
+            mint(manager, v, asset::from_string("100.00 RAM"), "ram report");
+        }
+        produce_blocks();
+
+        vector<name> endings = { name("delete"), name("archive"), name("digest") };
+        vector<name> ballot_names = make_names("lcb", endings.size());
+
+        for (size_t i = 0; i < endings.size(); i++) {
+            int64_t usage_before = get_total_usage(decide_name);
+            vector<step_cost> steps = run_lifecycle(ballot_names[i], voters, endings[i]);
+            int64_t usage_after = get_total_usage(decide_name);
+
+            print_lifecycle(endings[i], steps);
+
+            //ram billed to actions must match the table model
+            int64_t billed = 0;
+            for (const auto& s : steps) {
+                billed += s.ram_bytes;
+            }
+            BOOST_REQUIRE_EQUAL(billed, usage_after - usage_before);
+        }
+
+    } FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,223 @@
+// LZ4 block codec and compressed detail encoding for Telos Decide ballot details.
+//
+// Compressed details are stored on chain exactly as submitted:
+//   "DZ" || codec (uint8, 1 = lz4 block) || original size (uint32 LE) || lz4 block
+//
+// The payload is a standard LZ4 block, so any LZ4 block decoder (including browser
+// implementations) can decompress it after skipping the 7 byte header.
+//
+// @author Craig Branscom
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace decidetools {
+
+    const uint8_t detail_codec_lz4 = 1;
+    const size_t detail_header_size = 7;
+
+    namespace lz4_detail {
+
+        const size_t min_match = 4;
+        const size_t last_literals = 5; //last 5 bytes are always literals
+        const size_t match_limit = 12; //last match must start 12 bytes before end
+        const size_t max_offset = 65535;
+        const int hash_bits = 16;
+
+        inline uint32_t read32(const uint8_t* p) {
+            uint32_t v;
+            memcpy(&v, p, 4);
+            return v;
+        }
+
+        inline uint32_t hash32(uint32_t seq) {
+            return (seq * 2654435761u) >> (32 - hash_bits);
+        }
+
+        inline void write_length(std::vector<uint8_t>& out, size_t len) {
+            len -= 15;
+            while (len >= 255) {
+                out.push_back(255);
+                len -= 255;
+            }
+            out.push_back(uint8_t(len));
+        }
+
+        inline void write_sequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literal_len,
+            size_t offset, size_t match_len) {
+            size_t ml_code = match_len - min_match;
+            uint8_t token = uint8_t((literal_len >= 15 ? 15 : literal_len) << 4);
+            token |= uint8_t(ml_code >= 15 ? 15 : ml_code);
+            out.push_back(token);
+
+            if (literal_len >= 15) {
+                write_length(out, literal_len);
+            }
+            out.insert(out.end(), literals, literals + literal_len);
+
+            out.push_back(uint8_t(offset & 0xff));
+            out.push_back(uint8_t(offset >> 8));
+
+            if (ml_code >= 15) {
+                write_length(out, ml_code);
+            }
+        }
+
+        inline void write_last_literals(std::vector<uint8_t>& out, const uint8_t* literals, size_t literal_len) {
+            out.push_back(uint8_t((literal_len >= 15 ? 15 : literal_len) << 4));
+            if (literal_len >= 15) {
+                write_length(out, literal_len);
+            }
+            out.insert(out.end(), literals, literals + literal_len);
+        }
+
+        inline size_t read_length(const uint8_t*& ip, const uint8_t* end) {
+            size_t len = 0;
+            uint8_t b;
+            do {
+                if (ip >= end) {
+                    throw std::invalid_argument("truncated lz4 length");
+                }
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+            return len;
+        }
+
+    }
+
+    //compresses bytes into a single lz4 block using greedy hash matching
+    inline std::vector<uint8_t> lz4_compress(const uint8_t* src, size_t src_len) {
+        using namespace lz4_detail;
+
+        std::vector<uint8_t> out;
+        std::vector<int64_t> table(size_t(1) << hash_bits, -1);
+        size_t anchor = 0;
+        size_t i = 0;
+
+        while (src_len >= match_limit && i + match_limit <= src_len) {
+            uint32_t seq = read32(src + i);
+            uint32_t h = hash32(seq);
+            int64_t ref = table[h];
+            table[h] = int64_t(i);
+
+            if (ref >= 0 && i - size_t(ref) <= max_offset && read32(src + ref) == seq) {
+                size_t match_len = min_match;
+                size_t max_len = src_len - last_literals - i;
+                while (match_len < max_len && src[size_t(ref) + match_len] == src[i + match_len]) {
+                    match_len++;
+                }
+
+                write_sequence(out, src + anchor, i - anchor, i - size_t(ref), match_len);
+                i += match_len;
+                anchor = i;
+            } else {
+                i++;
+            }
+        }
+
+        write_last_literals(out, src + anchor, src_len - anchor);
+        return out;
+    }
+
+    //decompresses a single lz4 block, throws if block is malformed or doesn't match expected size
+    inline std::vector<uint8_t> lz4_decompress(const uint8_t* src, size_t src_len, size_t expected_len) {
+        using namespace lz4_detail;
+
+        std::vector<uint8_t> out;
+        out.reserve(expected_len);
+        const uint8_t* ip = src;
+        const uint8_t* end = src + src_len;
+
+        while (ip < end) {
+            uint8_t token = *ip++;
+
+            //copy literals
+            size_t literal_len = token >> 4;
+            if (literal_len == 15) {
+                literal_len += read_length(ip, end);
+            }
+            if (size_t(end - ip) < literal_len || out.size() + literal_len > expected_len) {
+                throw std::invalid_argument("lz4 literals out of bounds");
+            }
+            out.insert(out.end(), ip, ip + literal_len);
+            ip += literal_len;
+
+            //last sequence has no match
+            if (ip == end) {
+                break;
+            }
+
+            //copy match
+            if (end - ip < 2) {
+                throw std::invalid_argument("truncated lz4 offset");
+            }
+            size_t offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > out.size()) {
+                throw std::invalid_argument("invalid lz4 match offset");
+            }
+
+            size_t match_len = token & 0x0f;
+            if (match_len == 15) {
+                match_len += read_length(ip, end);
+            }
+            match_len += min_match;
+            if (out.size() + match_len > expected_len) {
+                throw std::invalid_argument("lz4 match out of bounds");
+            }
+
+            //byte copy handles overlapping matches
+            size_t match_start = out.size() - offset;
+            for (size_t k = 0; k < match_len; k++) {
+                out.push_back(out[match_start + k]);
+            }
+        }
+
+        if (out.size() != expected_len) {
+            throw std::invalid_argument("lz4 block doesn't match original size");
+        }
+        return out;
+    }
+
+    //encodes a ballot description or content as a compressed detail
+    inline std::vector<uint8_t> encode_detail(const std::string& detail) {
+        if (detail.empty() || detail.size() > UINT32_MAX) {
+            throw std::invalid_argument("detail must be between 1 byte and 4 GiB");
+        }
+
+        std::vector<uint8_t> out = { 'D', 'Z', detail_codec_lz4 };
+        uint32_t original_size = uint32_t(detail.size());
+        for (int i = 0; i < 4; i++) {
+            out.push_back(uint8_t(original_size >> (8 * i)));
+        }
+
+        auto block = lz4_compress(reinterpret_cast<const uint8_t*>(detail.data()), detail.size());
+        out.insert(out.end(), block.begin(), block.end());
+        return out;
+    }
+
+    //decodes a compressed detail back to the original string
+    inline std::string decode_detail(const std::vector<uint8_t>& encoded) {
+        if (encoded.size() <= detail_header_size || encoded[0] != 'D' || encoded[1] != 'Z') {
+            throw std::invalid_argument("invalid compressed detail header");
+        }
+        if (encoded[2] != detail_codec_lz4) {
+            throw std::invalid_argument("unsupported detail codec");
+        }
+
+        uint32_t original_size = 0;
+        for (int i = 0; i < 4; i++) {
+            original_size |= uint32_t(encoded[3 + i]) << (8 * i);
+        }
+
+        auto out = lz4_decompress(encoded.data() + detail_header_size, encoded.size() - detail_header_size, original_size);
+        return std::string(out.begin(), out.end());
+    }
+
+}
@@ -0,0 +1,145 @@
+// Merkle tree builder and proof generator for Telos Decide merkle ballots.
+//
+// Leaves and nodes are hashed exactly as decide::verify_merkle_proof() does on chain:
+//   leaf = sha256(0x00 || account name (uint64 LE) || weight amount (int64 LE))
+//   node = sha256(0x01 || lesser child || greater child)
+//
+// @author Craig Branscom
+
+#pragma once
+
+#include "sha256.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace decidetools {
+
+    //converts an account name string to its uint64 value
+    inline uint64_t name_to_value(const std::string& str) {
+        if (str.size() > 13) {
+            throw std::invalid_argument("name is longer than 13 characters: " + str);
+        }
+
+        auto char_to_value = [&](char c) -> uint64_t {
+            if (c == '.') return 0;
+            if (c >= '1' && c <= '5') return uint64_t(c - '1') + 1;
+            if (c >= 'a' && c <= 'z') return uint64_t(c - 'a') + 6;
+            throw std::invalid_argument("invalid character in name: " + str);
+        };
+
+        uint64_t value = 0;
+        for (size_t i = 0; i < str.size(); i++) {
+            uint64_t c = char_to_value(str[i]);
+            if (i < 12) {
+                value |= (c & 0x1f) << (64 - 5 * (i + 1));
+            } else {
+                if (c > 0x0f) {
+                    throw std::invalid_argument("thirteenth character in name cannot be a letter after j: " + str);
+                }
+                value |= c;
+            }
+        }
+        return value;
+    }
+
+    struct balance_leaf {
+        std::string account;
+        int64_t weight;
+    };
+
+    inline hash256 hash_leaf(uint64_t account_value, int64_t weight) {
+        uint8_t data[17];
+        data[0] = 0x00;
+        memcpy(data + 1, &account_value, 8);
+        memcpy(data + 9, &weight, 8);
+        return sha256(data, sizeof(data));
+    }
+
+    inline hash256 hash_node(hash256 lhs, hash256 rhs) {
+        if (rhs < lhs) {
+            std::swap(lhs, rhs);
+        }
+        uint8_t data[65];
+        data[0] = 0x01;
+        memcpy(data + 1, lhs.data(), 32);
+        memcpy(data + 33, rhs.data(), 32);
+        return sha256(data, sizeof(data));
+    }
+
+    class merkle_tree {
+
+    public:
+
+        //builds tree from balances, leaves are ordered by account name
+        explicit merkle_tree(std::vector<balance_leaf> balances) : leaves(std::move(balances)) {
+            if (leaves.empty()) {
+                throw std::invalid_argument("cannot build merkle tree without balances");
+            }
+
+            std::sort(leaves.begin(), leaves.end(), [](const balance_leaf& a, const balance_leaf& b) {
+                return name_to_value(a.account) < name_to_value(b.account);
+            });
+
+            std::vector<hash256> level;
+            for (size_t i = 0; i < leaves.size(); i++) {
+                if (i > 0 && leaves[i].account == leaves[i - 1].account) {
+                    throw std::invalid_argument("duplicate account in balances: " + leaves[i].account);
+                }
+                level.push_back(hash_leaf(name_to_value(leaves[i].account), leaves[i].weight));
+            }
+            levels.push_back(level);
+
+            //odd nodes are promoted to the next level unchanged
+            while (levels.back().size() > 1) {
+                const auto& prev = levels.back();
+                std::vector<hash256> next;
+                for (size_t i = 0; i < prev.size(); i += 2) {
+                    next.push_back(i + 1 < prev.size() ? hash_node(prev[i], prev[i + 1]) : prev[i]);
+                }
+                levels.push_back(next);
+            }
+        }
+
+        hash256 root() const { return levels.back().front(); }
+
+        const std::vector<balance_leaf>& balances() const { return leaves; }
+
+        //returns sibling hashes from leaf to root for account
+        std::vector<hash256> proof(const std::string& account) const {
+            auto itr = std::find_if(leaves.begin(), leaves.end(), [&](const balance_leaf& l) { return l.account == account; });
+            if (itr == leaves.end()) {
+                throw std::invalid_argument("account not found in balances: " + account);
+            }
+
+            std::vector<hash256> siblings;
+            size_t index = size_t(itr - leaves.begin());
+            for (size_t l = 0; l + 1 < levels.size(); l++) {
+                size_t sibling = index ^ 1;
+                if (sibling < levels[l].size()) {
+                    siblings.push_back(levels[l][sibling]);
+                }
+                index /= 2;
+            }
+            return siblings;
+        }
+
+        //verifies a proof the same way the decide contract does
+        static bool verify(const hash256& root, const std::string& account, int64_t weight, const std::vector<hash256>& siblings) {
+            hash256 node = hash_leaf(name_to_value(account), weight);
+            for (const auto& sibling : siblings) {
+                node = hash_node(node, sibling);
+            }
+            return node == root;
+        }
+
+    private:
+
+        std::vector<balance_leaf> leaves;
+        std::vector<std::vector<hash256>> levels;
+
+    };
+
+}
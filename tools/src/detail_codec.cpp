@@ -0,0 +1,74 @@
+// Compresses and decompresses Telos Decide ballot details for the editdetailsz action.
+//
+// Compressed output is written as raw bytes, or as hex with the hex commands for pasting
+// into cleos (vector<char> fields take hex strings).
+//
+// @author Craig Branscom
+
+#include "lz4.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+using namespace std;
+using namespace decidetools;
+
+void usage_info() {
+    cerr << "Usage: detail_codec compress <input_file> <output_file>" << endl;
+    cerr << "       detail_codec decompress <input_file> <output_file>" << endl;
+    cerr << "       detail_codec compresshex <input_file>" << endl;
+}
+
+vector<uint8_t> read_file(const string& path) {
+    ifstream file(path, ios::binary);
+    if (!file) {
+        throw invalid_argument("cannot open file: " + path);
+    }
+    return vector<uint8_t>(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+void write_file(const string& path, const vector<uint8_t>& data) {
+    ofstream file(path, ios::binary);
+    if (!file) {
+        throw invalid_argument("cannot open file: " + path);
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage_info();
+        return 1;
+    }
+
+    string command = argv[1];
+
+    try {
+        auto input = read_file(argv[2]);
+
+        if (command == "compress" && argc == 4) {
+            auto encoded = encode_detail(string(input.begin(), input.end()));
+            write_file(argv[3], encoded);
+            cerr << input.size() << " -> " << encoded.size() << " bytes" << endl;
+        } else if (command == "decompress" && argc == 4) {
+            string decoded = decode_detail(input);
+            write_file(argv[3], vector<uint8_t>(decoded.begin(), decoded.end()));
+        } else if (command == "compresshex") {
+            auto encoded = encode_detail(string(input.begin(), input.end()));
+            static const char* digits = "0123456789abcdef";
+            for (uint8_t b : encoded) {
+                cout << digits[b >> 4] << digits[b & 0x0f];
+            }
+            cout << endl;
+        } else {
+            usage_info();
+            return 1;
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Builds merkle roots and proofs for Telos Decide merkle ballots from a balances file.
+//
+// Balances file format: one "account weight" pair per line, weight in raw token units
+// (e.g. 1000.00 GOO is 100000). Blank lines and lines starting with # are ignored.
+//
+// @author Craig Branscom
+
+#include "merkle.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace decidetools;
+
+void usage_info() {
+    cerr << "Usage: merkle_tool root <balances_file>" << endl;
+    cerr << "       merkle_tool proof <balances_file> <account>" << endl;
+    cerr << "       merkle_tool proofs <balances_file>" << endl;
+}
+
+vector<balance_leaf> read_balances(const string& path) {
+    ifstream file(path);
+    if (!file) {
+        throw invalid_argument("cannot open balances file: " + path);
+    }
+
+    vector<balance_leaf> balances;
+    string line;
+    size_t line_num = 0;
+    while (getline(file, line)) {
+        line_num++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        istringstream ss(line);
+        balance_leaf leaf;
+        if (!(ss >> leaf.account >> leaf.weight) || leaf.weight <= 0) {
+            throw invalid_argument("invalid balance on line " + to_string(line_num) + ": " + line);
+        }
+        balances.push_back(leaf);
+    }
+    return balances;
+}
+
+string proof_json(const merkle_tree& tree, const balance_leaf& leaf) {
+    ostringstream out;
+    out << "{\"account\":\"" << leaf.account << "\",\"weight\":" << leaf.weight << ",\"proof\":[";
+    auto siblings = tree.proof(leaf.account);
+    for (size_t i = 0; i < siblings.size(); i++) {
+        out << (i > 0 ? "," : "") << "\"" << to_hex(siblings[i]) << "\"";
+    }
+    out << "]}";
+    return out.str();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage_info();
+        return 1;
+    }
+
+    string command = argv[1];
+
+    try {
+        merkle_tree tree(read_balances(argv[2]));
+
+        if (command == "root") {
+            cout << to_hex(tree.root()) << endl;
+        } else if (command == "proof" && argc == 4) {
+            string account = argv[3];
+            for (const auto& leaf : tree.balances()) {
+                if (leaf.account == account) {
+                    cout << proof_json(tree, leaf) << endl;
+                    return 0;
+                }
+            }
+            throw invalid_argument("account not found in balances: " + account);
+        } else if (command == "proofs") {
+            cout << "{\"root\":\"" << to_hex(tree.root()) << "\",\"proofs\":[";
+            const auto& leaves = tree.balances();
+            for (size_t i = 0; i < leaves.size(); i++) {
+                cout << (i > 0 ? "," : "") << proof_json(tree, leaves[i]);
+            }
+            cout << "]}" << endl;
+        } else {
+            usage_info();
+            return 1;
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Native round-trip tests for the compressed detail codec.
+//
+// @author Craig Branscom
+
+#include "lz4.hpp"
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+using namespace decidetools;
+
+void test_round_trips() {
+    vector<string> inputs = {
+        "a",
+        "short detail",
+        string(1000, 'a'),
+        string(70000, 'b'),
+        "{\"content_version\":2,\"title\":\"Worker Proposal\",\"sections\":[{\"title\":\"Budget\",\"body\":\"...\"},"
+            "{\"title\":\"Budget\",\"body\":\"...\"},{\"title\":\"Budget\",\"body\":\"...\"}]}"
+    };
+
+    //pseudo random bytes don't compress but must still round trip
+    string noise;
+    uint32_t x = 12345;
+    for (int i = 0; i < 5000; i++) {
+        x = x * 1103515245 + 12345;
+        noise.push_back(char(x >> 24));
+    }
+    inputs.push_back(noise);
+
+    //repeated markdown compresses well
+    string markdown;
+    for (int i = 0; i < 100; i++) {
+        markdown += "## Section " + to_string(i % 7) + "\nThis proposal requests funding for the Telos Decide frontend.\n";
+    }
+    inputs.push_back(markdown);
+
+    for (const auto& input : inputs) {
+        auto encoded = encode_detail(input);
+        assert(encoded[0] == 'D' && encoded[1] == 'Z' && encoded[2] == detail_codec_lz4);
+        assert(decode_detail(encoded) == input);
+    }
+
+    assert(encode_detail(markdown).size() < markdown.size() / 4);
+    assert(encode_detail(string(70000, 'b')).size() < 400);
+}
+
+void test_known_block() {
+    //reference lz4 block for "aaaaaaaaaaaaaaaaaaaa": 1 literal, match offset 1 length 14, 5 literals
+    vector<uint8_t> block = { 0x1a, 'a', 0x01, 0x00, 0x50, 'a', 'a', 'a', 'a', 'a' };
+    auto out = lz4_decompress(block.data(), block.size(), 20);
+    assert(string(out.begin(), out.end()) == string(20, 'a'));
+}
+
+void test_invalid_details() {
+    auto expect_throw = [](const vector<uint8_t>& encoded) {
+        bool threw = false;
+        try {
+            decode_detail(encoded);
+        } catch (const invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    };
+
+    auto encoded = encode_detail(string(500, 'c'));
+
+    //bad magic
+    auto bad_magic = encoded;
+    bad_magic[0] = 'X';
+    expect_throw(bad_magic);
+
+    //unknown codec
+    auto bad_codec = encoded;
+    bad_codec[2] = 9;
+    expect_throw(bad_codec);
+
+    //wrong original size
+    auto bad_size = encoded;
+    bad_size[3] += 1;
+    expect_throw(bad_size);
+
+    //truncated block
+    auto truncated = encoded;
+    truncated.resize(truncated.size() - 3);
+    expect_throw(truncated);
+
+    //header only
+    expect_throw(vector<uint8_t>(encoded.begin(), encoded.begin() + detail_header_size));
+}
+
+int main() {
+    test_round_trips();
+    test_known_block();
+    test_invalid_details();
+    cout << "lz4 tests passed" << endl;
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Native tests for the merkle ballot tooling.
+//
+// @author Craig Branscom
+
+#include "merkle.hpp"
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+using namespace decidetools;
+
+void test_sha256_vectors() {
+    assert(to_hex(sha256("", 0)) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    assert(to_hex(sha256("abc", 3)) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    string long_input(1000, 'a');
+    assert(to_hex(sha256(long_input.data(), long_input.size())) == "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+}
+
+void test_name_to_value() {
+    assert(name_to_value("") == 0);
+    assert(name_to_value("eosio") == 6138663577826885632ULL);
+    assert(name_to_value("eosio.token") == 6138663591592764928ULL);
+}
+
+void test_single_leaf() {
+    merkle_tree tree({{"testaccounta", 1000}});
+    assert(tree.root() == hash_leaf(name_to_value("testaccounta"), 1000));
+    assert(tree.proof("testaccounta").empty());
+    assert(merkle_tree::verify(tree.root(), "testaccounta", 1000, {}));
+}
+
+void test_proofs() {
+    vector<balance_leaf> balances = {
+        {"testaccounte", 500}, {"testaccounta", 100}, {"testaccountc", 300},
+        {"testaccountb", 200}, {"testaccountd", 400}
+    };
+    merkle_tree tree(balances);
+
+    for (const auto& b : balances) {
+        auto proof = tree.proof(b.account);
+        assert(merkle_tree::verify(tree.root(), b.account, b.weight, proof));
+        assert(!merkle_tree::verify(tree.root(), b.account, b.weight + 1, proof));
+    }
+
+    //two leaves hash into the root directly
+    merkle_tree pair_tree({{"testaccountb", 200}, {"testaccounta", 100}});
+    auto leaf_a = hash_leaf(name_to_value("testaccounta"), 100);
+    auto leaf_b = hash_leaf(name_to_value("testaccountb"), 200);
+    assert(pair_tree.root() == hash_node(leaf_a, leaf_b));
+    assert(pair_tree.root() == hash_node(leaf_b, leaf_a));
+}
+
+void test_invalid_balances() {
+    bool threw = false;
+    try {
+        merkle_tree tree({{"testaccounta", 1}, {"testaccounta", 2}});
+    } catch (const invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        merkle_tree tree({});
+    } catch (const invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+int main() {
+    test_sha256_vectors();
+    test_name_to_value();
+    test_single_leaf();
+    test_proofs();
+    test_invalid_balances();
+    cout << "merkle tests passed" << endl;
+    return 0;
+}